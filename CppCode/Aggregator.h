@@ -1,6 +1,7 @@
 #ifndef AGGREGATOR_H
 #define AGGREGATOR_H
 
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 
@@ -8,9 +9,16 @@ namespace crr {
 
 	/**
 	 * @brief Interface abstraite pour l'agrégation des prix path-dépendants.
+	 * @details Le long d'une trajectoire, l'agrégateur tient un état (somme, somme des logarithmes,
+	 *          maximum ou minimum des prix) : start() au prix initial, update() à chaque prix, puis
+	 *          finalize() avec le nombre de prix agrégés. Une mise à jour coûte au plus une
+	 *          addition et un logarithme, sans débordement quel que soit le nombre de pas.
+	 *          operator() donne la même valeur agrégée directement à partir de la précédente.
 	 */
 	class Aggregator {
 	public:
+		virtual ~Aggregator() = default;
+
 		/**
 		 * @brief Calcule la nouvelle valeur agrégée.
 		 * @param agg   Valeur agrégée jusqu'à l'étape précédente.
@@ -19,25 +27,80 @@ namespace crr {
 		 * @return Valeur agrégée mise à jour.
 		 */
 		virtual double operator()(double agg, double price, double step) const = 0;
+
+		/**
+		 * @brief État initial, après le seul prix S0.
+		 */
+		virtual double start(double S0) const = 0;
+
+		/**
+		 * @brief État après un prix supplémentaire.
+		 */
+		virtual double update(double state, double price) const = 0;
+
+		/**
+		 * @brief Valeur agrégée à partir de l'état.
+		 * @param count Nombre de prix agrégés, S0 compris.
+		 */
+		virtual double finalize(double state, int count) const = 0;
+
+		/**
+		 * @brief Mise à jour de n trajectoires : state[i] = update(state[i], price[i]).
+		 */
+		virtual void updatePaths(double* state, const double* price, int n) const {
+			for (int i = 0; i < n; ++i)
+				state[i] = update(state[i], price[i]);
+		}
+
+		/**
+		 * @brief Valeurs agrégées de n trajectoires : out[i] = finalize(state[i], count).
+		 */
+		virtual void finalizePaths(const double* state, int count, double* out, int n) const {
+			for (int i = 0; i < n; ++i)
+				out[i] = finalize(state[i], count);
+		}
 	};
 
 	/**
-	 * @brief Agrégateur pour la moyenne arithmétique.
+	 * @brief Agrégateur pour la moyenne arithmétique (état : somme des prix).
 	 */
 	class Arithmetic : public Aggregator {
 	public:
 		double operator()(double agg, double price, double step) const override {
 			return (agg * step + price) / (step + 1);
 		}
+		double start(double S0) const override { return S0; }
+		double update(double state, double price) const override { return state + price; }
+		double finalize(double state, int count) const override { return state / count; }
+		void updatePaths(double* state, const double* price, int n) const override {
+			for (int i = 0; i < n; ++i)
+				state[i] += price[i];
+		}
+		void finalizePaths(const double* state, int count, double* out, int n) const override {
+			for (int i = 0; i < n; ++i)
+				out[i] = state[i] / count;
+		}
 	};
 
 	/**
-	 * @brief Agrégateur pour la moyenne géométrique.
+	 * @brief Agrégateur pour la moyenne géométrique (état : somme des logarithmes des prix).
 	 */
 	class Geometric : public Aggregator {
 	public:
 		double operator()(double agg, double price, double step) const override {
-			return std::pow(std::pow(agg, step) * price, 1.0 / (step + 1));
+			// (agg^step price)^(1/(step+1)) sans élever agg à la puissance step, qui déborde
+			return agg * std::pow(price / agg, 1.0 / (step + 1));
+		}
+		double start(double S0) const override { return std::log(S0); }
+		double update(double state, double price) const override { return state + std::log(price); }
+		double finalize(double state, int count) const override { return std::exp(state / count); }
+		void updatePaths(double* state, const double* price, int n) const override {
+			for (int i = 0; i < n; ++i)
+				state[i] += std::log(price[i]);
+		}
+		void finalizePaths(const double* state, int count, double* out, int n) const override {
+			for (int i = 0; i < n; ++i)
+				out[i] = std::exp(state[i] / count);
 		}
 	};
 
@@ -49,6 +112,16 @@ namespace crr {
 		double operator()(double agg, double price, double step) const override {
 			return std::max<double>(agg, price);
 		}
+		double start(double S0) const override { return S0; }
+		double update(double state, double price) const override { return std::max<double>(state, price); }
+		double finalize(double state, int) const override { return state; }
+		void updatePaths(double* state, const double* price, int n) const override {
+			for (int i = 0; i < n; ++i)
+				state[i] = std::max<double>(state[i], price[i]);
+		}
+		void finalizePaths(const double* state, int, double* out, int n) const override {
+			std::copy(state, state + n, out);
+		}
 	};
 
 	/**
@@ -59,8 +132,18 @@ namespace crr {
 		double operator()(double agg, double price, double step) const override {
 			return std::min<double>(agg, price);
 		}
+		double start(double S0) const override { return S0; }
+		double update(double state, double price) const override { return std::min<double>(state, price); }
+		double finalize(double state, int) const override { return state; }
+		void updatePaths(double* state, const double* price, int n) const override {
+			for (int i = 0; i < n; ++i)
+				state[i] = std::min<double>(state[i], price[i]);
+		}
+		void finalizePaths(const double* state, int, double* out, int n) const override {
+			std::copy(state, state + n, out);
+		}
 	};
 
-} // namespace crr 
+} // namespace crr
 
 #endif // AGGREGATOR_H
@@ -2,6 +2,10 @@
 #define AMERICAN_H
 
 #include "Option.h"
+#include "StockTree.h"
+#include "Payoff.h"
+#include "Kernels.h"
+#include "Tiling.h"
 
 namespace crr {
 
@@ -13,13 +17,169 @@ namespace crr {
     class American : public Option {
     private:
         TPayoff payoff_;                                
-        std::vector<std::vector<double>> stockTree_;  ///< Arbre recombiné du sous-jacent
-        void buildStockTree();
+        StockTree stockTree_;  ///< Arbre recombiné du sous-jacent
+
+        /**
+         * @brief Payoffs à l’échéance (N + 1 valeurs).
+         */
+        AlignedVector terminalValues() const;
+
+        /**
+         * @brief Lissage BBS : remplace le niveau N par les valeurs de Black-Scholes sur un pas au niveau N - 1 (maximum avec l’exercice).
+         */
+        void smooth(AlignedVector& V) const;
+
+        /**
+         * @brief Rétropropagation en place avec exercice du niveau from au niveau to.
+         * @param V Niveau from en entrée ; V[0..to] contient le niveau to en sortie.
+         */
+        void induction(AlignedVector& V, int from, int to) const;
+
+        /**
+         * @brief Vrai si la région d’exercice est un intervalle au bord du niveau, délimité par la
+         *        frontière : payoff déclarant son côté (opt::ExerciseRegion) et taux strictement positif.
+         */
+        bool tracksBoundary() const;
+
+        /**
+         * @brief Nœud (n, i) du j-ième nœud compté depuis le côté de l’exercice.
+         */
+        int fromExerciseSide(int n, int j) const;
+
+        /**
+         * @brief Niveau n à partir du niveau n + 1 en suivant la frontière d’exercice.
+         * @details Les nœuds dont les deux fils sont exercés le sont aussi (put, taux > 0) : leur
+         *          continuation n’est pas calculée et, si fill est faux, seul le dernier, lu au
+         *          niveau suivant, est écrit. Le balayage part de la frontière du niveau n + 1 et s’arrête au premier
+         *          nœud de continuation ; le reste du niveau est une simple rétropropagation, sans
+         *          payoff ni maximum. Mêmes valeurs que stepMax() sur les nœuds écrits.
+         * @param next    Niveau n + 1.
+         * @param cur     Niveau n ; peut être égal à next (mise à jour en place).
+         * @param k       Nombre de nœuds exercés au niveau n + 1, comptés depuis le côté de l’exercice.
+         * @param fill    Écrire aussi les nœuds exercés non évalués.
+         * @param exer    Tampon d’au moins n + 1 valeurs.
+         * @param unwritten Nombre de nœuds non écrits, comptés depuis le côté de l’exercice.
+         * @return Nombre de nœuds exercés au niveau n.
+         */
+        int boundaryStep(const double* next, double* cur, int n, int k, bool fill, double* exer,
+            int& unwritten) const;
+
+        /**
+         * @brief Rétropropagation en place du niveau from au niveau to en suivant la frontière.
+         * @param V        Niveau from en entrée ; V[0..to] contient le niveau to en sortie.
+         * @param boundary Si non nul, reçoit S*(t_n) pour n = to..from (NaN sans nœud exercé).
+         */
+        void boundaryInduction(double* V, int from, int to, double* boundary) const;
+
+        /**
+         * @brief Nombre de nœuds exercés au niveau n, comptés depuis le côté de l’exercice.
+         */
+        int exercisedCount(const double* V, int n) const;
 
     public:
-        American(double S0, double R, double sigma, double T, int N, const TPayoff& payoff);
-        std::vector<std::vector<double>> treePrice() const override;
-        HedgingStrategy hedgingStrategy() const override;
+        /**
+         * @brief Couverture de la martingale de Doob M = V + A sur l’arbre recombinant.
+         * @details Le compensateur A_{n+1} est connu en n : le delta ne dépend que du nœud et
+         *          bond(n, i) = V(n, i) - delta(n, i) S(n, i). La position en actif sans risque
+         *          d’une trajectoire vaut bond(n, i) + A_n, A étant accumulé le long de la
+         *          trajectoire par A_{k+1} = (A_k + increment(k, i_k)) / discount (voir pathPosition()).
+         */
+        struct Hedging : HedgingStrategy<TriangularLattice> {
+            TriangularLattice increment;  ///< V(n, i) moins la valeur de continuation : incrément de A sur [n, n + 1].
+        };
+
+        /**
+         * @brief Frontière d’exercice anticipé.
+         */
+        struct ExerciseBoundary {
+            double price;               ///< Valeur de l’option à n = 0.
+            std::vector<double> time;   ///< Dates t_n = n T / N, n = 0..N.
+            std::vector<double> stock;  ///< S*(t_n) : prix exercé le plus proche de la continuation (NaN si aucun).
+        };
+
+        /**
+         * @brief Couverture sur l’arbre non recombinant (2^n nœuds au niveau n).
+         */
+        using HedgingNR = HedgingStrategy<std::vector<std::vector<double>>>;
+
+        /**
+         * @brief Position de couverture au bout d’une trajectoire.
+         */
+        struct PathPosition {
+            int n;               ///< Niveau atteint.
+            int i;               ///< Nœud atteint (nombre de hausses).
+            double delta;        ///< Position en sous-jacent.
+            double bond;         ///< Position en actif sans risque, compensateur inclus.
+            double compensator;  ///< Compensateur A_n de la trajectoire.
+        };
+
+        American(double S0, double R, double sigma, double T, int N, const TPayoff& payoff,
+            const Settings& settings = Settings());
+        TriangularLattice treePrice() const;
+
+        /**
+         * @brief Couverture sur l’arbre recombinant, en O(N²) calculs et mémoire.
+         */
+        Hedging hedgingStrategy() const;
+
+        /**
+         * @brief Position le long d’une trajectoire, en O(n).
+         * @param H     Couverture renvoyée par hedgingStrategy().
+         * @param moves moves[k] vaut true si le pas k est une hausse (moins de N pas).
+         */
+        PathPosition pathPosition(const Hedging& H, const std::vector<bool>& moves) const;
+
+        /**
+         * @brief Couverture développée sur l’arbre non recombinant, trajectoire par trajectoire.
+         * @details Même disposition que les exports historiques : réservé aux petits N.
+         */
+        HedgingNR hedgingStrategyNR() const;
+
+        /**
+         * @brief Prix initial par rétropropagation en place dans un tampon de N+1 valeurs.
+         * @details Pavée dans le temps si Settings::tileWidth > 0 : l’exercice n’est alors évalué
+         *          que sur la portion de niveau couverte par la tuile. Parallèle sur les grands
+         *          niveaux si Settings::threads != 1 (voir parallelInduction). Sinon, pour un call
+         *          ou un put, suit la frontière d’exercice (voir boundaryStep) : sans évaluer l’exercice
+         *          dans la région de continuation, ce chemin reste plus rapide que le pavage.
+         * @return Valeur de l’option à n = 0, identique à treePrice()(0, 0) sans lissage.
+         */
+        double price() const override;
+        Greeks greeks() const override;
+
+        /**
+         * @brief Prix et frontière d’exercice S*(t) en une rétropropagation (sans lissage).
+         * @details Réservé aux payoffs déclarant leur région d’exercice (call, put), avec un taux > 0
+         *          pour le call. La frontière est vide (NaN) avant l’échéance pour le call, et pour le put
+         *          lorsque le taux est <= 0 : il n’est alors jamais exercé par anticipation.
+         */
+        ExerciseBoundary exerciseBoundary() const;
+
+        /**
+         * @brief Extrapolation de Richardson des sensibilités sur une échelle de pas.
+         * @details Chaque membre de l’échelle est valorisé par greeks() (prix, delta, gamma et
+         *          theta du même arbre), en parallèle si Settings::threads != 1 ; le tableau de
+         *          Neville en 1/N est ensuite appliqué à chaque grandeur. Chaque membre construit son
+         *          propre arbre et ses tampons : les tables de puissances du sous-jacent dépendent de dt,
+         *          donc de N, et ne peuvent pas être partagées ; les tampons en O(N) ne sont pas réutilisés.
+         * @param ladder Nombres de pas, croissants (par exemple N, 2N, 4N).
+         * @param order  Ordre d’extrapolation, de 0 à ladder.size() - 1 ; les order + 1 arbres
+         *               les plus fins sont utilisés.
+         */
+        Greeks richardson(const std::vector<int>& ladder, int order) const;
+
+        /**
+         * @brief Extrapolation sur l’échelle N, 2N, ..., 2^(k-1) N avec k = Settings::richardsonLevels,
+         *        à l’ordre maximal (pas arrondis à l’impair supérieur pour Leisen-Reimer).
+         */
+        Greeks richardson() const;
+
+        /**
+         * @brief BBSR : 2 BBS(N) - BBS(N/2), soit richardson({ N/2, N }, 1) sur des arbres lissés.
+         * @details Utilisé par price() et greeks() lorsque Settings::smoothing vaut Smoothing::BBSR.
+         *          Avec Leisen-Reimer, les arbres ne sont pas lissés et N/2 est arrondi à l’impair.
+         */
+        Greeks bbsr() const;
 
         /**
          * @brief Prix asymptotique de l’option (extrapolation répétée de Richardson).
@@ -28,7 +188,7 @@ namespace crr {
         double priceRR() const;
 
         /**
-         * @brief Delta asymptotique (bump-and-reprice).
+         * @brief Delta asymptotique, extrapolé à partir des deltas des mêmes arbres que priceRR().
          * @return Valeur du delta à n = 0.
          */
         double deltaRR() const;
@@ -36,150 +196,388 @@ namespace crr {
 
     template<typename TPayoff>
     American<TPayoff>::American(double S0, double R, double sigma,
-        double T, int N, const TPayoff& payoff)
-        : Option(S0, R, sigma, T, N), payoff_(payoff)
+        double T, int N, const TPayoff& payoff, const Settings& settings)
+        : Option(S0, R, sigma, T, N, settings, payoff.strike()), payoff_(payoff),
+          stockTree_(S0_, u_, d_, N_, settings_.storage)
     {
-        buildStockTree();
     }
 
     template<typename TPayoff>
-    void American<TPayoff>::buildStockTree() {
-        stockTree_.assign(N_ + 1, {});
-        for (int n = 0; n <= N_; ++n) {
-            stockTree_[n].resize(n + 1);
-            for (int i = 0; i <= n; ++i) {
-                stockTree_[n][i] = S0_ * std::pow(1 + u_, i) * std::pow(1 + d_, n - i);
-            }
+    TriangularLattice American<TPayoff>::treePrice() const {
+        TriangularLattice V(N_ + 1);
+        AlignedVector scratch(N_ + 1), exer(N_ + 1);
+        const double* SN = stockTree_.level(N_, scratch.data());
+        payoff_.evaluate(SN, V[N_].data(), N_ + 1);
+
+        if (tracksBoundary()) {
+            int k = exercisedCount(V[N_].data(), N_), unwritten;
+            for (int n = N_ - 1; n >= 0; --n)
+                k = boundaryStep(V[n + 1].data(), V[n].data(), n, k, true, exer.data(), unwritten);
+            return V;
+        }
+
+        for (int n = N_ - 1; n >= 0; --n) {
+            const double* S = stockTree_.level(n, scratch.data());
+            payoff_.evaluate(S, exer.data(), n + 1);
+            simd::stepMax(V[n + 1].data(), exer.data(), V[n].data(), n + 1, pu_, pd_);
         }
+        return V;
     }
 
     template<typename TPayoff>
-    std::vector<std::vector<double>> American<TPayoff>::treePrice() const {
-        std::vector<std::vector<double>> V(N_ + 1);
-        V[N_].resize(N_ + 1);
-        for (int i = 0; i <= N_; ++i)
-            V[N_][i] = payoff_(stockTree_[N_][i]);
+    bool American<TPayoff>::tracksBoundary() const {
+        // Taux > 0 : le put n’a qu’une frontière, le call n’est jamais exercé avant l’échéance
+        return payoff_.exerciseRegion() != opt::ExerciseRegion::Unknown && discount_ < 1.0;
+    }
 
-        for (int n = N_ - 1; n >= 0; --n) {
-            V[n].resize(n + 1);
-            for (int i = 0; i <= n; ++i) {
-                double cont = discount_ * 0.5 * (V[n + 1][i + 1] + V[n + 1][i]);
-                double exer = payoff_(stockTree_[n][i]);
-                V[n][i] = std::max<double>(exer, cont);
-            }
+    template<typename TPayoff>
+    int American<TPayoff>::fromExerciseSide(int n, int j) const {
+        return payoff_.exerciseRegion() == opt::ExerciseRegion::Below ? j : n - j;
+    }
+
+    template<typename TPayoff>
+    int American<TPayoff>::exercisedCount(const double* V, int n) const {
+        int k = 0;
+        for (; k <= n; ++k) {
+            int i = fromExerciseSide(n, k);
+            double e = payoff_(stockTree_(n, i));
+            if (!(e > 0.0 && V[i] == e))
+                break;
         }
+        return k;
+    }
+
+    template<typename TPayoff>
+    int American<TPayoff>::boundaryStep(const double* next, double* cur, int n, int k, bool fill,
+        double* exer, int& unwritten) const
+    {
+        bool below = payoff_.exerciseRegion() == opt::ExerciseRegion::Below;
+
+        // Put : deux fils exercés donnent une continuation K / (1 + r) - S < K - S
+        int start = below ? std::min<int>(std::max<int>(k - 1, 0), n + 1) : 0;
+        int j = start;
+        for (; j <= n; ++j) {
+            int i = fromExerciseSide(n, j);
+            double e = payoff_(stockTree_(n, i));
+            if (!(e > 0.0 && e >= pu_ * next[i + 1] + pd_ * next[i]))
+                break;
+            exer[j] = e;
+        }
+
+        // Continuation d’abord : en place, elle lit les valeurs du niveau n + 1 côté exercice
+        int count = n + 1 - j;
+        int i0 = below ? j : 0;
+        if (cur == next)
+            simd::rollback(cur + i0, count, pu_, pd_);
+        else
+            simd::step(next + i0, cur + i0, count, pu_, pd_);
+
+        for (int jj = start; jj < j; ++jj)
+            cur[fromExerciseSide(n, jj)] = exer[jj];
+
+        // Nœuds supposés exercés : le dernier est lu au niveau suivant
+        unwritten = fill ? 0 : std::max<int>(start - 1, 0);
+        int known = start - unwritten;
+        if (known > 0) {
+            int first = below ? unwritten : n + 1 - start;
+            const double* S = stockTree_.range(n, first, known, exer);
+            payoff_.evaluate(S, cur + first, known);
+        }
+        return j;
+    }
+
+    template<typename TPayoff>
+    void American<TPayoff>::boundaryInduction(double* V, int from, int to, double* boundary) const {
+        AlignedVector exer(from + 1);
+        int k = exercisedCount(V, from), unwritten = 0;
+        auto record = [&](int n) {
+            if (boundary)
+                boundary[n] = k > 0 ? stockTree_(n, fromExerciseSide(n, k - 1)) : std::nan("");
+        };
+        record(from);
+        for (int n = from - 1; n >= to; --n) {
+            k = boundaryStep(V, V, n, k, false, exer.data(), unwritten);
+            record(n);
+        }
+        for (int j = 0; j < unwritten; ++j) {
+            int i = fromExerciseSide(to, j);
+            V[i] = payoff_(stockTree_(to, i));
+        }
+    }
+
+    template<typename TPayoff>
+    AlignedVector American<TPayoff>::terminalValues() const {
+        AlignedVector V(N_ + 1);
+        payoff_.evaluate(stockTree_.level(N_, V.data()), V.data(), N_ + 1);
         return V;
     }
 
     template<typename TPayoff>
-    Option::HedgingStrategy American<TPayoff>::hedgingStrategy() const {
-        // 0) Construction de l'arbre non recombinant
-        std::vector<std::vector<double>> stockTreeNR;
-        int N = N_;
-        stockTreeNR.assign(N + 1, {});
-        stockTreeNR[0] = { S0_ };
-        for (int n = 1; n <= N; ++n) {
-            int sz = 1 << n;
-            stockTreeNR[n].resize(sz);
-            for (int j = 0; j < sz; ++j) {
-                bool up = (j & 1);
-                double prev = stockTreeNR[n - 1][j >> 1];
-                stockTreeNR[n][j] = prev * (1 + (up ? u_ : d_));
+    void American<TPayoff>::smooth(AlignedVector& V) const {
+        double dt = T_ / N_;
+        const double* S = stockTree_.level(N_ - 1, V.data());
+        for (int i = 0; i < N_; ++i)
+            V[i] = std::max<double>(payoff_(S[i]), payoff_.blackScholes(S[i], R_, sigma_, dt));
+    }
+
+    template<typename TPayoff>
+    void American<TPayoff>::induction(AlignedVector& V, int from, int to) const {
+        int top = from;
+        if (settings_.threads != 1) {
+            // Tampons du sous-jacent et de l’exercice propres à chaque thread, alloués avant
+            // la tâche : une allocation qui échouerait entre deux barrières n’y a pas lieu
+            int threads = threadCount(settings_.threads);
+            std::vector<AlignedVector> Sbuf(threads, AlignedVector(from + 1)), Ebuf(threads, AlignedVector(from + 1));
+            top = parallelInduction(V.data(), from, to, settings_, [&](int t, int n, int i0, int count, double* W) {
+                const double* S = stockTree_.range(n, i0, count, Sbuf[t].data());
+                payoff_.evaluate(S, Ebuf[t].data(), count);
+                simd::rollbackMax(W, Ebuf[t].data(), count, pu_, pd_);
+            });
+        }
+        if (top <= to)
+            return;
+
+        // Mise à jour en place, comme pour l’option européenne
+        AlignedVector scratch(top), exer(top);
+        if (settings_.tileWidth > 0) {
+            tiledInduction(top, to, settings_.tileWidth, settings_.tileLevels, [&](int n, int i0, int count) {
+                const double* S = stockTree_.range(n, i0, count, scratch.data());
+                payoff_.evaluate(S, exer.data(), count);
+                simd::rollbackMax(V.data() + i0, exer.data(), count, pu_, pd_);
+            });
+        }
+        else if (tracksBoundary()) {
+            boundaryInduction(V.data(), top, to, nullptr);
+        }
+        else {
+            for (int n = top - 1; n >= to; --n) {
+                const double* S = stockTree_.level(n, scratch.data());
+                payoff_.evaluate(S, exer.data(), n + 1);
+                simd::rollbackMax(V.data(), exer.data(), n + 1, pu_, pd_);
             }
         }
+    }
 
-        // 1) Calcul de VNR sur arbre non recombinant
-        std::vector<std::vector<double>> VNR(N + 1);
-        VNR[N].resize(1 << N);
-        for (int j = 0; j < (1 << N); ++j)
-            VNR[N][j] = payoff_(stockTreeNR[N][j]);
+    template<typename TPayoff>
+    double American<TPayoff>::price() const {
+        if (settings_.smoothing == Smoothing::BBSR)
+            return bbsr().price;
+        AlignedVector V = terminalValues();
+        int level = N_;
+        if (smoothsLastStep()) {
+            smooth(V);
+            --level;
+        }
+        induction(V, level, 0);
+        return V[0];
+    }
 
-        for (int n = N - 1; n >= 0; --n) {
-            int sz = 1 << n;
-            VNR[n].resize(sz);
-            for (int j = 0; j < sz; ++j) {
-                double cont = discount_ * 0.5 * (VNR[n + 1][2 * j] + VNR[n + 1][2 * j + 1]);
-                VNR[n][j] = std::max<double>(payoff_(stockTreeNR[n][j]), cont);
-            }
+    template<typename TPayoff>
+    typename American<TPayoff>::Greeks American<TPayoff>::greeks() const {
+        if (settings_.smoothing == Smoothing::BBSR)
+            return bbsr();
+        // Niveaux 0 à 2 relevés au passage ; avec le lissage, le niveau N reste le payoff
+        double L[3][3];
+        AlignedVector V = terminalValues();
+        auto save = [&](int n) {
+            if (n <= 2)
+                std::copy(V.begin(), V.begin() + n + 1, L[n]);
+        };
+        int level = N_;
+        save(level);
+        if (smoothsLastStep()) {
+            smooth(V);
+            save(--level);
+        }
+        if (level > 2) {
+            induction(V, level, 2);
+            level = 2;
+            save(level);
         }
+        for (; level > 0; --level) {
+            induction(V, level, level - 1);
+            save(level - 1);
+        }
+        return greeksFromLevels(L[0][0], L[1], N_ >= 2 ? L[2] : nullptr);
+    }
 
-        // 2) Calcul des incréments de compensateur 
-        std::vector<std::vector<double>> incr(N);
-        for (int n = 0; n < N; ++n) {
-            int sz = 1 << n;
-            incr[n].resize(sz);
-            for (int j = 0; j < sz; ++j) {
-                double cont = discount_ * 0.5 * (VNR[n + 1][2 * j] + VNR[n + 1][2 * j + 1]);
-                incr[n][j] = VNR[n][j] - cont;
-            }
+    template<typename TPayoff>
+    typename American<TPayoff>::ExerciseBoundary American<TPayoff>::exerciseBoundary() const {
+        // Taux <= 0 : la continuation du put vaut au moins K - S (parité), il n’est jamais exercé avant l’échéance
+        bool putWithoutRate = payoff_.exerciseRegion() == opt::ExerciseRegion::Below && discount_ >= 1.0;
+        if (!tracksBoundary() && !putWithoutRate)
+            throw std::invalid_argument("Frontière d'exercice réservée au call avec un taux > 0 et au put");
+        ExerciseBoundary B;
+        B.time.resize(N_ + 1);
+        B.stock.assign(N_ + 1, std::nan(""));
+        for (int n = 0; n <= N_; ++n)
+            B.time[n] = n * T_ / N_;
+        AlignedVector V = terminalValues();
+        if (putWithoutRate) {
+            int k = exercisedCount(V.data(), N_);
+            if (k > 0)
+                B.stock[N_] = stockTree_(N_, fromExerciseSide(N_, k - 1));
+            induction(V, N_, 0);
+        }
+        else {
+            boundaryInduction(V.data(), N_, 0, B.stock.data());
         }
+        B.price = V[0];
+        return B;
+    }
 
-        // 3) Propagation forward pour A et calcul de M
-        std::vector<std::vector<double>> A(N + 1), M(N + 1);
-        A[0].resize(1);
-        M[0].resize(1);
-        A[0][0] = 0;
-        M[0][0] = VNR[0][0];
-        for (int n = 1; n <= N; ++n) {
-            int sz = 1 << n;
-            A[n].resize(sz);
-            M[n].resize(sz);
-            for (int j = 0; j < sz; ++j) {
-                double prevA = A[n - 1][j >> 1];  // j/2 pour la Fn-1 mesurabilité de An
-                double inc = incr[n - 1][j >> 1];
-                A[n][j] = (prevA + inc) / discount_;  // faut confronter avec Vn, valeurs de An-1 e incr dans n-1
-                M[n][j] = VNR[n][j] + A[n][j];
+    template<typename TPayoff>
+    typename American<TPayoff>::Hedging American<TPayoff>::hedgingStrategy() const {
+        auto V = treePrice();
+        Hedging H{ { TriangularLattice(N_), TriangularLattice(N_) }, TriangularLattice(N_) };
+        AlignedVector scratch[2] = { AlignedVector(N_ + 1), AlignedVector(N_ + 1) };  // niveaux n et n + 1
+        const double* Snext = stockTree_.level(N_, scratch[N_ & 1].data());
+        for (int n = N_ - 1; n >= 0; --n) {
+            const double* S = stockTree_.level(n, scratch[n & 1].data());
+            for (int i = 0; i <= n; ++i) {
+                double Vu = V(n + 1, i + 1);
+                double Vd = V(n + 1, i);
+                // A_{n+1} est connu en n : il s'annule dans la différence M_u - M_d
+                double dlt = (Vu - Vd) / (Snext[i + 1] - Snext[i]);
+                H.delta(n, i) = dlt;
+                H.bond(n, i) = V(n, i) - dlt * S[i];
+                H.increment(n, i) = V(n, i) - (pu_ * Vu + pd_ * Vd);
             }
+            Snext = S;
         }
+        return H;
+    }
+
+    template<typename TPayoff>
+    typename American<TPayoff>::PathPosition American<TPayoff>::pathPosition(const Hedging& H,
+        const std::vector<bool>& moves) const
+    {
+        int n = static_cast<int>(moves.size());
+        if (n >= N_)
+            throw std::invalid_argument("La trajectoire doit compter moins de N pas");
+
+        int i = 0;
+        double A = 0.0;
+        for (int k = 0; k < n; ++k) {
+            A = (A + H.increment(k, i)) / discount_;
+            if (moves[k])
+                ++i;
+        }
+        return { n, i, H.delta(n, i), H.bond(n, i) + A, A };
+    }
 
-        // 4) Couverture sur la martingale M
-        HedgingStrategy H;
-        H.delta.resize(N);
-        H.bond.resize(N);
-        for (int n = 0; n < N; ++n) {
+    template<typename TPayoff>
+    typename American<TPayoff>::HedgingNR American<TPayoff>::hedgingStrategyNR() const {
+        if (N_ >= 31)
+            throw std::invalid_argument("N trop grand pour l'arbre non recombinant");
+        auto H = hedgingStrategy();
+
+        // Le nœud j du niveau n a pour fils 2j (baisse) et 2j + 1 (hausse) ;
+        // on propage le nombre de hausses et le compensateur de chaque trajectoire
+        HedgingNR R;
+        R.delta.resize(N_);
+        R.bond.resize(N_);
+        std::vector<int> ups = { 0 }, nextUps;
+        std::vector<double> A = { 0.0 }, nextA;
+        for (int n = 0; n < N_; ++n) {
             int sz = 1 << n;
-            H.delta[n].resize(sz);
-            H.bond[n].resize(sz);
+            R.delta[n].resize(sz);
+            R.bond[n].resize(sz);
+            nextUps.resize(2 * sz);
+            nextA.resize(2 * sz);
             for (int j = 0; j < sz; ++j) {
-                double Mu = M[n + 1][2 * j + 1];
-                double Md = M[n + 1][2 * j];
-                double Su = stockTreeNR[n + 1][2 * j + 1];
-                double Sd = stockTreeNR[n + 1][2 * j];
-                double dlt = (Mu - Md) / (Su - Sd);
-                H.delta[n][j] = dlt;
-                H.bond[n][j] = M[n][j] - dlt * stockTreeNR[n][j];
+                int i = ups[j];
+                R.delta[n][j] = H.delta(n, i);
+                R.bond[n][j] = H.bond(n, i) + A[j];
+                nextUps[2 * j] = i;
+                nextUps[2 * j + 1] = i + 1;
+                nextA[2 * j] = nextA[2 * j + 1] = (A[j] + H.increment(n, i)) / discount_;
             }
+            ups.swap(nextUps);
+            A.swap(nextA);
         }
-        return H;
+        return R;
     }
 
     template<typename TPayoff>
-    double American<TPayoff>::priceRR() const {
-        std::vector<int> Ns = { 100, 200, 400 };
-        int n = Ns.size(), m = 2;
-        std::vector<std::vector<double>> A(n, std::vector<double>(m + 1));
-        for (int i = 0; i < n; ++i) {
-            American<TPayoff> opt(S0_, R_, sigma_, T_, Ns[i], payoff_);
-            A[i][0] = opt.price();
-        }
-
-        for (int k = 1; k <= m; ++k) {
-            for (int i = 0; i + k < n; ++i) {
-                double ratio = Ns[i + k] / Ns[i];
-                A[i][k] = A[i + 1][k - 1] + (A[i + 1][k - 1] - A[i][k - 1]) / (ratio - 1.0);
+    typename American<TPayoff>::Greeks American<TPayoff>::richardson(const std::vector<int>& ladder, int order) const {
+        int m = static_cast<int>(ladder.size());
+        if (m == 0)
+            throw std::invalid_argument("L'échelle de Richardson est vide");
+        if (order < 0 || order >= m)
+            throw std::invalid_argument("L'ordre de Richardson doit être compris entre 0 et la taille de l'échelle - 1");
+
+        // Un arbre par membre de l'échelle ; chacun reste séquentiel à l'intérieur
+        std::vector<Greeks> G(m);
+        Settings inner = settings_;
+        inner.threads = 1;
+        int threads = std::min<int>(threadCount(settings_.threads), m);
+        auto task = [&](int t) {
+            for (int i = m - 1 - t; i >= 0; i -= threads)
+                G[i] = American<TPayoff>(S0_, R_, sigma_, T_, ladder[i], payoff_, inner).greeks();
+        };
+        if (threads <= 1 || !ThreadPool::instance().run(threads, task)) {
+            threads = 1;
+            task(0);
+        }
+
+        // Tableau de Neville en h = 1/N, extrapolé vers h = 0 à partir des arbres les plus fins
+        auto extrapolate = [&](double Greeks::* field) {
+            std::vector<std::vector<double>> A(m, std::vector<double>(order + 1));
+            for (int i = 0; i < m; ++i)
+                A[i][0] = G[i].*field;
+            for (int k = 1; k <= order; ++k) {
+                for (int i = 0; i + k < m; ++i) {
+                    double ratio = static_cast<double>(ladder[i + k]) / ladder[i];
+                    A[i][k] = A[i + 1][k - 1] + (A[i + 1][k - 1] - A[i][k - 1]) / (ratio - 1.0);
+                }
             }
+            return A[m - 1 - order][order];
+        };
+
+        Greeks R;
+        R.price = extrapolate(&Greeks::price);
+        R.delta = extrapolate(&Greeks::delta);
+        R.gamma = extrapolate(&Greeks::gamma);
+        R.theta = extrapolate(&Greeks::theta);
+        return R;
+    }
+
+    template<typename TPayoff>
+    typename American<TPayoff>::Greeks American<TPayoff>::richardson() const {
+        int levels = std::max<int>(settings_.richardsonLevels, 1);
+        std::vector<int> ladder(levels);
+        for (int k = 0; k < levels; ++k) {
+            ladder[k] = N_ << k;
+            // Leisen-Reimer ne converge régulièrement qu'avec un nombre de pas impair
+            if (settings_.parameterization == Parameterization::LeisenReimer)
+                ladder[k] |= 1;
         }
-        return A[0][m];
+        return richardson(ladder, levels - 1);
+    }
+
+    template<typename TPayoff>
+    typename American<TPayoff>::Greeks American<TPayoff>::bbsr() const {
+        Settings bbs = settings_;
+        bbs.smoothing = Smoothing::BBS;
+        American<TPayoff> tree(S0_, R_, sigma_, T_, N_, payoff_, bbs);
+        if (N_ < 4)
+            return tree.greeks();
+        // Même règle de pas impairs que richardson()
+        int half = N_ / 2;
+        if (settings_.parameterization == Parameterization::LeisenReimer)
+            half |= 1;
+        return tree.richardson({ half, N_ }, 1);
+    }
+
+    template<typename TPayoff>
+    double American<TPayoff>::priceRR() const {
+        return richardson().price;
     }
 
     template<typename TPayoff>
     double American<TPayoff>::deltaRR() const {
-        double eps = 1e-4 * S0_;
-        American<TPayoff> up(S0_ + eps, R_, sigma_, T_, N_, payoff_);
-        American<TPayoff> dn(S0_ - eps, R_, sigma_, T_, N_, payoff_);
-        double priceUp = up.priceRR();
-        double priceDn = dn.priceRR();
-        return (priceUp - priceDn) / (2 * eps);
+        return richardson().delta;
     }
 
 } // namespace crr
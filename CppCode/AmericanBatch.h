@@ -0,0 +1,275 @@
+#ifndef AMERICANBATCH_H
+#define AMERICANBATCH_H
+
+#include "Option.h"
+#include "StockTree.h"
+#include "Payoff.h"
+#include "Kernels.h"
+#include <algorithm>
+
+namespace crr {
+
+    /**
+     * @brief Livre d’options américaines de même type (call ou put) et de strikes différents,
+     *        valorisées ensemble sur un seul arbre du sous-jacent.
+     * @details Les valeurs sont rangées nœud par nœud, les strikes entrelacés (V[i M + m]) :
+     *          chaque pas de rétropropagation et son maximum avec l’exercice sont vectorisés sur
+     *          les strikes (simd::rollbackMaxStrikes). Les lignes où toutes les options sont hors
+     *          de la monnaie n’ont ni payoff ni maximum (simd::rollbackStrided) ; pour un put à
+     *          taux positif, celles où toutes sont exercées ne sont pas calculées (voir
+     *          American::boundaryStep). Pour chaque strike, les valeurs sont identiques au bit
+     *          près à celles de American<TPayoff>.
+     *          Pas de lissage, de pavage ni de parallélisme ; Leisen-Reimer se centre sur le strike
+     *          médian si Settings::strike vaut 0.
+     * @tparam TPayoff opt::PayoffPut ou opt::PayoffCall.
+     */
+    template<typename TPayoff>
+    class AmericanBatch : public Option {
+    private:
+        std::vector<double> strikes_;     ///< Strikes, dans l’ordre donné
+        std::vector<double> quantities_;  ///< Quantités détenues de chaque option
+        int M_;                           ///< Largeur d’une ligne : nombre de strikes arrondi au multiple de 8
+        AlignedVector K_;                 ///< Strikes complétés par le dernier jusqu’à M_
+        bool put_;
+        double Kmin_, Kmax_;
+        StockTree stockTree_;
+
+        static double medianStrike(std::vector<double> strikes);
+
+        /**
+         * @brief Payoffs à l’échéance, (N + 1) lignes de M_ valeurs.
+         */
+        AlignedVector terminalValues() const;
+
+        /**
+         * @brief Rétropropagation en place du niveau from au niveau to.
+         * @param V Niveau from en entrée ; les lignes 0..to contiennent le niveau to en sortie.
+         */
+        void induction(AlignedVector& V, int from, int to) const;
+
+        /**
+         * @brief Lignes i0..i0 + count - 1 d’un niveau, en place à partir du niveau suivant.
+         * @param S Prix du sous-jacent de ces lignes.
+         */
+        void stepRows(double* V, const double* S, int i0, int count) const;
+
+        /**
+         * @brief Première ligne j' >= j du niveau n non exercée pour au moins un strike (put).
+         */
+        int exercisedRows(const double* V, const double* S, int n, int j) const;
+
+    public:
+        /**
+         * @param strikes    Strikes du livre (au moins un).
+         * @param settings   Paramètres numériques (paramétrisation et stockage du sous-jacent).
+         * @param quantities Quantités détenues, une par strike (vide : une option de chaque).
+         */
+        AmericanBatch(double S0, double R, double sigma, double T, int N, const std::vector<double>& strikes,
+            const Settings& settings = Settings(), const std::vector<double>& quantities = std::vector<double>());
+
+        /**
+         * @brief Nombre d’options du livre.
+         */
+        int size() const { return static_cast<int>(strikes_.size()); }
+
+        /**
+         * @brief Prix de chaque option, dans l’ordre des strikes.
+         */
+        std::vector<double> prices() const;
+
+        /**
+         * @brief Sensibilités de chaque option, lues sur les niveaux 0 à 2 de la même rétropropagation.
+         */
+        std::vector<Greeks> strikeGreeks() const;
+
+        /**
+         * @brief Valeur du livre : somme des prix pondérés par les quantités.
+         */
+        double price() const override;
+
+        /**
+         * @brief Sensibilités du livre : somme des sensibilités pondérées par les quantités.
+         */
+        Greeks greeks() const override;
+    };
+
+    template<typename TPayoff>
+    AmericanBatch<TPayoff>::AmericanBatch(double S0, double R, double sigma, double T, int N,
+        const std::vector<double>& strikes, const Settings& settings, const std::vector<double>& quantities)
+        : Option(S0, R, sigma, T, N, settings, medianStrike(strikes)), strikes_(strikes), quantities_(quantities),
+          stockTree_(S0_, u_, d_, N_, settings_.storage)
+    {
+        opt::ExerciseRegion region = TPayoff(strikes_.front()).exerciseRegion();
+        if (region == opt::ExerciseRegion::Unknown)
+            throw std::invalid_argument("Le livre n'accepte que des calls ou des puts");
+        put_ = region == opt::ExerciseRegion::Below;
+
+        if (quantities_.empty())
+            quantities_.assign(strikes_.size(), 1.0);
+        if (quantities_.size() != strikes_.size())
+            throw std::invalid_argument("Une quantité par strike");
+
+        M_ = (size() + 7) / 8 * 8;
+        K_.assign(M_, strikes_.back());
+        std::copy(strikes_.begin(), strikes_.end(), K_.begin());
+        Kmin_ = *std::min_element(strikes_.begin(), strikes_.end());
+        Kmax_ = *std::max_element(strikes_.begin(), strikes_.end());
+    }
+
+    template<typename TPayoff>
+    double AmericanBatch<TPayoff>::medianStrike(std::vector<double> strikes) {
+        if (strikes.empty())
+            throw std::invalid_argument("Le livre doit contenir au moins un strike");
+        for (double K : strikes) {
+            if (K < 0.0)
+                throw std::invalid_argument("Strike K doit être non-négatif");
+        }
+        std::nth_element(strikes.begin(), strikes.begin() + strikes.size() / 2, strikes.end());
+        return strikes[strikes.size() / 2];
+    }
+
+    template<typename TPayoff>
+    AlignedVector AmericanBatch<TPayoff>::terminalValues() const {
+        AlignedVector V(std::size_t(N_ + 1) * M_), scratch(N_ + 1);
+        const double* S = stockTree_.level(N_, scratch.data());
+        for (int i = 0; i <= N_; ++i) {
+            double* row = V.data() + std::size_t(i) * M_;
+            for (int m = 0; m < M_; ++m)
+                row[m] = put_ ? std::max<double>(K_[m] - S[i], 0.0) : std::max<double>(S[i] - K_[m], 0.0);
+        }
+        return V;
+    }
+
+    template<typename TPayoff>
+    void AmericanBatch<TPayoff>::stepRows(double* V, const double* S, int i0, int count) const {
+        // Lignes hors de la monnaie pour tous les strikes : exercice nul, continuation >= 0
+        int split = put_
+            ? static_cast<int>(std::lower_bound(S, S + count, Kmax_) - S)
+            : static_cast<int>(std::upper_bound(S, S + count, Kmin_) - S);
+        double* row = V + std::size_t(i0) * M_;
+
+        // Ordre croissant des lignes : chacune lit la suivante avant qu’elle soit écrite
+        if (put_) {
+            simd::rollbackMaxStrikes(row, S, K_.data(), M_, split, pu_, pd_, true);
+            simd::rollbackStrided(row + std::size_t(split) * M_, (count - split) * M_, M_, pu_, pd_);
+        }
+        else {
+            simd::rollbackStrided(row, split * M_, M_, pu_, pd_);
+            simd::rollbackMaxStrikes(row + std::size_t(split) * M_, S + split, K_.data(), M_,
+                count - split, pu_, pd_, false);
+        }
+    }
+
+    template<typename TPayoff>
+    int AmericanBatch<TPayoff>::exercisedRows(const double* V, const double* S, int n, int j) const {
+        for (; j <= n; ++j) {
+            const double* row = V + std::size_t(j) * M_;
+            for (int m = 0; m < size(); ++m) {
+                double e = K_[m] - S[j];
+                if (!(e > 0.0 && row[m] == e))
+                    return j;
+            }
+        }
+        return j;
+    }
+
+    template<typename TPayoff>
+    void AmericanBatch<TPayoff>::induction(AlignedVector& V, int from, int to) const {
+        AlignedVector scratch(from + 1);
+        // Put, taux > 0 : une ligne dont les deux filles sont exercées pour tous les strikes l’est aussi
+        bool tracks = put_ && discount_ < 1.0;
+        int k = tracks ? exercisedRows(V.data(), stockTree_.level(from, scratch.data()), from, 0) : 0;
+        int unwritten = 0;
+        for (int n = from - 1; n >= to; --n) {
+            const double* S = stockTree_.level(n, scratch.data());
+            int start = std::min<int>(std::max<int>(k - 1, 0), n + 1);
+            stepRows(V.data(), S + start, start, n + 1 - start);
+
+            // Lignes supposées exercées : seule la dernière est lue au niveau suivant
+            if (start > 0) {
+                double* row = V.data() + std::size_t(start - 1) * M_;
+                for (int m = 0; m < M_; ++m)
+                    row[m] = K_[m] - S[start - 1];
+            }
+            unwritten = std::max<int>(start - 1, 0);
+            if (tracks)
+                k = exercisedRows(V.data(), S, n, start);
+        }
+
+        if (unwritten > 0) {
+            const double* S = stockTree_.level(to, scratch.data());
+            for (int j = 0; j < unwritten; ++j) {
+                double* row = V.data() + std::size_t(j) * M_;
+                for (int m = 0; m < M_; ++m)
+                    row[m] = K_[m] - S[j];
+            }
+        }
+    }
+
+    template<typename TPayoff>
+    std::vector<double> AmericanBatch<TPayoff>::prices() const {
+        AlignedVector V = terminalValues();
+        induction(V, N_, 0);
+        return std::vector<double>(V.begin(), V.begin() + size());
+    }
+
+    template<typename TPayoff>
+    std::vector<typename AmericanBatch<TPayoff>::Greeks> AmericanBatch<TPayoff>::strikeGreeks() const {
+        // Niveaux 0 à 2 de chaque strike : L[n][i M + m]
+        std::vector<double> L[3];
+        AlignedVector V = terminalValues();
+        auto save = [&](int n) {
+            if (n <= 2)
+                L[n].assign(V.begin(), V.begin() + std::size_t(n + 1) * M_);
+        };
+        save(N_);
+        int level = N_;
+        if (level > 2) {
+            induction(V, level, 2);
+            level = 2;
+            save(level);
+        }
+        for (; level > 0; --level) {
+            induction(V, level, level - 1);
+            save(level - 1);
+        }
+
+        std::vector<Greeks> G(size());
+        for (int m = 0; m < size(); ++m) {
+            double V1[2] = { L[1][m], L[1][M_ + m] };
+            double V2[3] = { 0.0, 0.0, 0.0 };
+            if (N_ >= 2) {
+                V2[0] = L[2][m];
+                V2[1] = L[2][M_ + m];
+                V2[2] = L[2][2 * M_ + m];
+            }
+            G[m] = greeksFromLevels(L[0][m], V1, N_ >= 2 ? V2 : nullptr);
+        }
+        return G;
+    }
+
+    template<typename TPayoff>
+    double AmericanBatch<TPayoff>::price() const {
+        std::vector<double> P = prices();
+        double total = 0.0;
+        for (int m = 0; m < size(); ++m)
+            total += quantities_[m] * P[m];
+        return total;
+    }
+
+    template<typename TPayoff>
+    typename AmericanBatch<TPayoff>::Greeks AmericanBatch<TPayoff>::greeks() const {
+        Greeks total = { 0.0, 0.0, 0.0, 0.0 };
+        std::vector<Greeks> G = strikeGreeks();
+        for (int m = 0; m < size(); ++m) {
+            total.price += quantities_[m] * G[m].price;
+            total.delta += quantities_[m] * G[m].delta;
+            total.gamma += quantities_[m] * G[m].gamma;
+            total.theta += quantities_[m] * G[m].theta;
+        }
+        return total;
+    }
+
+} // namespace crr
+
+#endif // AMERICANBATCH_H
@@ -2,6 +2,10 @@
 #define ASIAN_H
 
 #include "Option.h"
+#include "Aggregator.h"
+#include "MonteCarlo.h"
+#include "StockTree.h"
+#include "ThreadPool.h"
 
 namespace crr {
 
@@ -15,28 +19,77 @@ namespace crr {
     private:
 		TPayoff payoff_;
 		TAggregator aggregator_;  
-        std::vector<std::vector<double>> stockTreeNR_;  ///< Arbre binomiale non recombinant des prix du sous-jacent
-        void buildStockTreeNR();                        ///< Génère l’arbre binomial non recombinant des prix du sous-jacent
+
+        /**
+         * @brief Valeur du sous-arbre issu d’un nœud du niveau n, parcouru en profondeur.
+         * @param S     Prix du sous-jacent au nœud.
+         * @param state État de l’agrégat au nœud (voir Aggregator::start).
+         */
+        double subtreeValue(int n, double S, double state) const;
+
+        /**
+         * @brief Premiers niveaux des valeurs, sans construire l’arbre.
+         * @details Les sous-arbres d’un niveau de découpe (au moins 16 par thread) sont des tâches
+         *          indépendantes, réparties avec vol de travail (parallelFor) ; chacune ne garde en
+         *          mémoire que la pile de son parcours en profondeur, soit O(N). Les niveaux
+         *          au-dessus sont rétropropagés ensuite.
+         * @param levels Niveaux demandés : le résultat contient au moins les niveaux 0 à min(levels, N).
+         */
+        std::vector<std::vector<double>> topLevels(int levels) const;
 
     public:
-        Asian(double S0, double R, double sigma, double T, int N, const TPayoff& payoff, const TAggregator& aggregator);
-        std::vector<std::vector<double>> treePrice() const override;
-        HedgingStrategy hedgingStrategy() const override;
+        /**
+         * @brief Couverture sur l’arbre non recombinant (2^n nœuds au niveau n).
+         */
+        using Hedging = HedgingStrategy<std::vector<std::vector<double>>>;
+
+        Asian(double S0, double R, double sigma, double T, int N, const TPayoff& payoff, const TAggregator& aggregator,
+            const Settings& settings = Settings());
+        std::vector<std::vector<double>> treePrice() const;
+        Hedging hedgingStrategy() const;
+
+        /**
+         * @brief Prix initial par parcours en profondeur, en mémoire O(N) par thread.
+         * @details Sur Settings::threads threads si l’arbre a au moins Settings::parallelCutoff
+         *          feuilles. Mêmes opérations que treePrice() : identique à treePrice()[0][0] au bit près.
+         */
+        double price() const override;
+
+        /**
+         * @brief Sensibilités lues sur les niveaux 0 à 2, calculés comme price().
+         * @details Deux trajectoires (hausse puis baisse, baisse puis hausse) mènent au même prix
+         *          du sous-jacent au niveau 2 : le gamma et le theta utilisent la moyenne de leurs
+         *          valeurs, soit l’espérance conditionnelle à ce prix.
+         */
+        Greeks greeks() const override;
 
         /**
          * @brief Valeurs terminales de l’option path-dépendante.
+         * @details L’état de l’agrégat de chaque nœud est obtenu en un pas à partir de celui de son
+         *          parent : O(2^N) mises à jour au lieu de O(N 2^N), un niveau entier à la fois
+         *          (Aggregator::updatePaths).
          * @return Vecteur des payoffs à l’échéance pour chaque trajectoire du sous-jacent.
          */
         std::vector<double> terminalValues() const; 
 
         /**
-         * @brief Prix asymptotique de l’option (méthode Monte Carlo).
+         * @brief Prix Monte Carlo de l’option et son erreur type.
+         * @details Settings::mcPaths trajectoires de Settings::mcSteps pas, pseudo-aléatoires ou
+         *          quasi-aléatoires selon Settings::mcSampling (voir MonteCarlo) ; à chaque pas,
+         *          les états des agrégats d’un bloc sont mis à jour ensemble.
+         */
+        MonteCarlo::Estimate estimateMC() const;
+
+        /**
+         * @brief Prix asymptotique de l’option (méthode Monte Carlo), voir estimateMC().
          * @return Valeur de l’option à n = 0.
          */
-        double priceMC() const;
+        double priceMC() const { return estimateMC().value; }
 
         /**
          * @brief Delta asymptotique (méthode bump-and-reprice).
+         * @details Les deux prix utilisent la même graine, donc les mêmes tirages (ou le même
+         *          brouillage de Sobol).
          * @return Valeur du delta à n = 0.
          */
         double deltaMC() const;
@@ -44,40 +97,31 @@ namespace crr {
 
     template<typename TPayoff, typename TAggregator>
     Asian<TPayoff, TAggregator>::Asian(double S0, double R, double sigma, double T, 
-        int N, const TPayoff& payoff, const TAggregator& aggregator)
-		: Option(S0, R, sigma, T, N), payoff_(payoff), aggregator_(aggregator)
+        int N, const TPayoff& payoff, const TAggregator& aggregator, const Settings& settings)
+		: Option(S0, R, sigma, T, N, settings, payoff.strike()), payoff_(payoff), aggregator_(aggregator)
     {
-        buildStockTreeNR();
-    }
-
-    template<typename TPayoff, typename TAggregator>
-    void Asian<TPayoff, TAggregator>::buildStockTreeNR() {
-        stockTreeNR_.assign(N_ + 1, {});
-        stockTreeNR_[0] = { S0_ };
-        for (int n = 1; n <= N_; ++n) {
-            int sz = 1 << n;  // 2^n
-            stockTreeNR_[n].resize(sz);
-            for (int j = 0; j < sz; ++j) {
-                bool up = (j & 1);  // up = 1 si j impair, 0 sinon
-                double prev = stockTreeNR_[n - 1][j >> 1];  // j/2
-                stockTreeNR_[n][j] = prev * (1 + (up ? u_ : d_));
-            }
-        }
     }
 
     template<typename TPayoff, typename TAggregator>
     std::vector<double> Asian<TPayoff, TAggregator>::terminalValues() const {
+        // Niveau par niveau, en place : le nœud j du niveau n ne lit que son parent j / 2,
+        // qui n'est écrasé qu'après lui dans l'ordre décroissant. Les états du niveau sont
+        // ensuite mis à jour d'un bloc par l'agrégateur.
         int leafSz = 1 << N_;
-        std::vector<double> vals(leafSz);
-        for (int j = 0; j < leafSz; ++j) {
-            double agg = S0_;
-            for (int n = 1; n <= N_; ++n) {
-                int idx = j >> (N_ - n);
-                agg = aggregator_(agg, stockTreeNR_[n][idx], n);
+        std::vector<double> state(leafSz), S(leafSz);
+        S[0] = S0_;
+        state[0] = aggregator_.start(S0_);
+        for (int n = 1; n <= N_; ++n) {
+            int sz = 1 << n;
+            for (int j = sz - 1; j >= 0; --j) {
+                S[j] = S[j >> 1] * (1 + ((j & 1) ? u_ : d_));
+                state[j] = state[j >> 1];
             }
-            vals[j] = payoff_(agg);
+            aggregator_.updatePaths(state.data(), S.data(), sz);
         }
-        return vals;
+        for (int j = 0; j < leafSz; ++j)
+            state[j] = payoff_(aggregator_.finalize(state[j], N_ + 1));
+        return state;
     }
 
     template<typename TPayoff, typename TAggregator>
@@ -93,15 +137,70 @@ namespace crr {
             int sz = 1 << n;
             V[n].resize(sz);
             for (int j = 0; j < sz; ++j)
-                V[n][j] = discount_ * 0.5 * (V[n + 1][2 * j + 1] + V[n + 1][2 * j]);
+                V[n][j] = pu_ * V[n + 1][2 * j + 1] + pd_ * V[n + 1][2 * j];
         }
         return V;
     }
 
     template<typename TPayoff, typename TAggregator>
-    Option::HedgingStrategy Asian<TPayoff, TAggregator>::hedgingStrategy() const {
+    double Asian<TPayoff, TAggregator>::subtreeValue(int n, double S, double state) const {
+        if (n == N_)
+            return payoff_(aggregator_.finalize(state, N_ + 1));
+        double Su = S * (1 + u_), Sd = S * (1 + d_);
+        return pu_ * subtreeValue(n + 1, Su, aggregator_.update(state, Su))
+             + pd_ * subtreeValue(n + 1, Sd, aggregator_.update(state, Sd));
+    }
+
+    template<typename TPayoff, typename TAggregator>
+    std::vector<std::vector<double>> Asian<TPayoff, TAggregator>::topLevels(int levels) const {
+        int threads = (std::size_t(1) << N_) >= std::size_t(settings_.parallelCutoff) ? threadCount(settings_.threads) : 1;
+        int depth = levels;
+        while (depth < N_ && (1 << depth) < 16 * threads)
+            ++depth;
+        depth = std::min<int>(depth, N_);
+
+        std::vector<std::vector<double>> V(depth + 1);
+        for (int n = 0; n <= depth; ++n)
+            V[n].resize(std::size_t(1) << n);
+
+        // Sous-arbre k : prix et agrégat le long des bits de k, du niveau 1 au niveau depth
+        auto subtree = [&](int k) {
+            double S = S0_, state = aggregator_.start(S0_);
+            for (int n = 1; n <= depth; ++n) {
+                bool up = (k >> (depth - n)) & 1;
+                S = S * (1 + (up ? u_ : d_));
+                state = aggregator_.update(state, S);
+            }
+            V[depth][k] = subtreeValue(depth, S, state);
+        };
+        parallelFor(threads, 1 << depth, subtree);
+
+        for (int n = depth - 1; n >= 0; --n) {
+            for (std::size_t j = 0; j < V[n].size(); ++j)
+                V[n][j] = pu_ * V[n + 1][2 * j + 1] + pd_ * V[n + 1][2 * j];
+        }
+        return V;
+    }
+
+    template<typename TPayoff, typename TAggregator>
+    double Asian<TPayoff, TAggregator>::price() const {
+        return topLevels(0)[0][0];
+    }
+
+    template<typename TPayoff, typename TAggregator>
+    typename Asian<TPayoff, TAggregator>::Greeks Asian<TPayoff, TAggregator>::greeks() const {
+        auto V = topLevels(2);
+        if (N_ < 2)
+            return greeksFromLevels(V[0][0], V[1].data(), nullptr);
+        double V2[3] = { V[2][0], 0.5 * (V[2][1] + V[2][2]), V[2][3] };
+        return greeksFromLevels(V[0][0], V[1].data(), V2);
+    }
+
+    template<typename TPayoff, typename TAggregator>
+    typename Asian<TPayoff, TAggregator>::Hedging Asian<TPayoff, TAggregator>::hedgingStrategy() const {
         auto V = treePrice();
-        HedgingStrategy H;
+        StockTreeNR S(S0_, u_, d_, N_);
+        Hedging H;
         H.delta.resize(N_);
         H.bond.resize(N_);
         for (int n = 0; n < N_; ++n) {
@@ -111,43 +210,35 @@ namespace crr {
             for (int j = 0; j < sz; ++j) {
                 double Vu = V[n + 1][2 * j + 1];
                 double Vd = V[n + 1][2 * j];
-                double Su = stockTreeNR_[n + 1][2 * j + 1];
-                double Sd = stockTreeNR_[n + 1][2 * j];
+                double Su = S(n + 1, 2 * j + 1);
+                double Sd = S(n + 1, 2 * j);
                 double dlt = (Vu - Vd) / (Su - Sd);
                 H.delta[n][j] = dlt;
-                H.bond[n][j] = V[n][j] - dlt * stockTreeNR_[n][j];
+                H.bond[n][j] = V[n][j] - dlt * S(n, j);
             }
         }
         return H;
     }
 
     template<typename TPayoff, typename TAggregator>
-    double Asian<TPayoff, TAggregator>::priceMC() const {
-        int steps = 100;
-        int paths = 10000;
-        std::mt19937_64 rng(42);
-        std::normal_distribution<double> nd(0.0, 1.0);
-        double dt = T_ / steps;
-        double discount = std::exp(-R_ * T_);
-        double sumPayoff = 0.0;
-        for (int i = 0; i < paths; ++i) {
-            double St = S0_;
-            double agg = S0_;
-            for (int j = 0; j < steps; ++j) {
-                double Z = nd(rng);
-                St *= std::exp((R_ - 0.5 * sigma_ * sigma_) * dt + sigma_ * std::sqrt(dt) * Z);
-                agg = aggregator_(agg, St, j + 1);
-            }
-            sumPayoff += payoff_(agg);
-        }
-        return discount * sumPayoff / paths;
+    MonteCarlo::Estimate Asian<TPayoff, TAggregator>::estimateMC() const {
+        MonteCarlo mc(S0_, R_, sigma_, T_, settings_);
+        int steps = mc.steps();
+        return mc.estimate([&](const double* S, int count, double* out) {
+            std::vector<double> state(count, aggregator_.start(S0_));
+            for (int j = 1; j <= steps; ++j)
+                aggregator_.updatePaths(state.data(), S + std::size_t(j) * count, count);
+            aggregator_.finalizePaths(state.data(), steps + 1, out, count);
+            for (int p = 0; p < count; ++p)
+                out[p] = payoff_(out[p]);
+        });
     }
 
     template<typename TPayoff, typename TAggregator>
     double Asian<TPayoff, TAggregator>::deltaMC() const {
         double eps = 1e-4 * S0_;
-        Asian<TPayoff, TAggregator> up(S0_ + eps, R_, sigma_, T_, N_, payoff_, aggregator_);
-        Asian<TPayoff, TAggregator> dn(S0_ - eps, R_, sigma_, T_, N_, payoff_, aggregator_);
+        Asian<TPayoff, TAggregator> up(S0_ + eps, R_, sigma_, T_, N_, payoff_, aggregator_, settings_);
+        Asian<TPayoff, TAggregator> dn(S0_ - eps, R_, sigma_, T_, N_, payoff_, aggregator_, settings_);
         double priceUp = up.priceMC();
         double priceDn = dn.priceMC();
         return (priceUp - priceDn) / (2 * eps);
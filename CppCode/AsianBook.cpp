@@ -0,0 +1,184 @@
+#include "pch.h"
+#include "AsianBook.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <stdexcept>
+#include <typeinfo>
+
+namespace crr {
+
+    AsianBook::AsianBook(double S0, double R, double sigma, double T, int N, const std::vector<Product>& products,
+        const Settings& settings)
+        : Option(S0, R, sigma, T, N, settings, firstStrike(products)), products_(products)
+    {
+        if (N_ >= 31)
+            throw std::invalid_argument("N trop grand pour l'arbre non recombinant");
+        // Les agrégateurs sont sans état propre : un seul état par type suffit
+        for (const Product& p : products_) {
+            if (!p.aggregator)
+                throw std::invalid_argument("Chaque produit doit avoir un agrégateur");
+            int a = 0;
+            while (a < aggregatorCount() && typeid(*aggregators_[a]) != typeid(*p.aggregator))
+                ++a;
+            if (a == aggregatorCount())
+                aggregators_.push_back(p.aggregator.get());
+            slot_.push_back(a);
+        }
+    }
+
+    double AsianBook::firstStrike(const std::vector<Product>& products) {
+        if (products.empty())
+            throw std::invalid_argument("Le livre doit contenir au moins un produit");
+        for (const Product& p : products) {
+            if (!p.payoff)
+                throw std::invalid_argument("Chaque produit doit avoir un payoff");
+        }
+        return products.front().payoff->strike();
+    }
+
+    void AsianBook::subtreeValues(int n, double S, int depth, Workspace& ws) const {
+        int A = aggregatorCount(), P = size();
+        double* state = ws.state.data() + std::size_t(depth) * A;
+        double* value = ws.value.data() + std::size_t(depth) * P;
+        if (N_ - n <= leafLevels) {
+            blockValues(n, S, state, value, ws);
+            return;
+        }
+        // Les fils écrivent au niveau depth + 1 de la pile
+        double* child = state + A;
+        const double* childValue = value + P;
+        double Su = S * (1 + u_), Sd = S * (1 + d_);
+        for (int a = 0; a < A; ++a)
+            child[a] = aggregators_[a]->update(state[a], Su);
+        subtreeValues(n + 1, Su, depth + 1, ws);
+        std::copy(childValue, childValue + P, value);
+        for (int a = 0; a < A; ++a)
+            child[a] = aggregators_[a]->update(state[a], Sd);
+        subtreeValues(n + 1, Sd, depth + 1, ws);
+        for (int p = 0; p < P; ++p)
+            value[p] = pu_ * value[p] + pd_ * childValue[p];
+    }
+
+    void AsianBook::blockValues(int n, double S, const double* state, double* value, Workspace& ws) const {
+        int A = aggregatorCount(), P = size();
+        int h = N_ - n;
+        int sz = 1 << h;
+        ws.S.resize(sz);
+        ws.blockState.resize(std::size_t(A) * sz);
+        ws.average.resize(std::size_t(A) * sz);
+        ws.blockValue.resize(sz);
+
+        // Niveau par niveau, en place comme Asian::terminalValues
+        double* Sb = ws.S.data();
+        Sb[0] = S;
+        for (int a = 0; a < A; ++a)
+            ws.blockState[std::size_t(a) * sz] = state[a];
+        for (int l = 1; l <= h; ++l) {
+            int width = 1 << l;
+            for (int j = width - 1; j >= 0; --j)
+                Sb[j] = Sb[j >> 1] * (1 + ((j & 1) ? u_ : d_));
+            for (int a = 0; a < A; ++a) {
+                double* st = ws.blockState.data() + std::size_t(a) * sz;
+                for (int j = width - 1; j > 0; --j)
+                    st[j] = st[j >> 1];
+                aggregators_[a]->updatePaths(st, Sb, width);
+            }
+        }
+        for (int a = 0; a < A; ++a) {
+            aggregators_[a]->finalizePaths(ws.blockState.data() + std::size_t(a) * sz, N_ + 1,
+                ws.average.data() + std::size_t(a) * sz, sz);
+        }
+
+        double* v = ws.blockValue.data();
+        for (int p = 0; p < P; ++p) {
+            products_[p].payoff->evaluate(ws.average.data() + std::size_t(slot_[p]) * sz, v, sz);
+            for (int l = h - 1; l >= 0; --l) {
+                for (int j = 0; j < (1 << l); ++j)
+                    v[j] = pu_ * v[2 * j + 1] + pd_ * v[2 * j];
+            }
+            value[p] = v[0];
+        }
+    }
+
+    std::vector<std::vector<double>> AsianBook::topLevels(int levels) const {
+        int A = aggregatorCount(), P = size();
+        int threads = (std::size_t(1) << N_) >= std::size_t(settings_.parallelCutoff) ? threadCount(settings_.threads) : 1;
+        int depth = levels;
+        while (depth < N_ && (1 << depth) < 16 * threads)
+            ++depth;
+        depth = std::min<int>(depth, N_);
+
+        std::vector<std::vector<double>> V(depth + 1);
+        for (int n = 0; n <= depth; ++n)
+            V[n].resize((std::size_t(1) << n) * P);
+
+        // Sous-arbre k : prix et états le long des bits de k, du niveau 1 au niveau depth
+        auto subtree = [&](int k) {
+            Workspace ws;
+            ws.state.resize(std::size_t(N_ - depth + 1) * A);
+            ws.value.resize(std::size_t(N_ - depth + 1) * P);
+            double S = S0_;
+            for (int a = 0; a < A; ++a)
+                ws.state[a] = aggregators_[a]->start(S0_);
+            for (int n = 1; n <= depth; ++n) {
+                bool up = (k >> (depth - n)) & 1;
+                S = S * (1 + (up ? u_ : d_));
+                for (int a = 0; a < A; ++a)
+                    ws.state[a] = aggregators_[a]->update(ws.state[a], S);
+            }
+            subtreeValues(depth, S, 0, ws);
+            std::copy(ws.value.begin(), ws.value.begin() + P, V[depth].begin() + std::size_t(k) * P);
+        };
+        parallelFor(threads, 1 << depth, subtree);
+
+        for (int n = depth - 1; n >= 0; --n) {
+            for (std::size_t j = 0; j < (std::size_t(1) << n); ++j) {
+                for (int p = 0; p < P; ++p)
+                    V[n][j * P + p] = pu_ * V[n + 1][(2 * j + 1) * P + p] + pd_ * V[n + 1][2 * j * P + p];
+            }
+        }
+        return V;
+    }
+
+    std::vector<double> AsianBook::prices() const {
+        auto V = topLevels(0);
+        return std::vector<double>(V[0].begin(), V[0].begin() + size());
+    }
+
+    std::vector<AsianBook::Greeks> AsianBook::productGreeks() const {
+        int P = size();
+        auto V = topLevels(2);
+        std::vector<Greeks> G(P);
+        for (int p = 0; p < P; ++p) {
+            double V1[2] = { V[1][p], V[1][P + p] };
+            if (N_ < 2) {
+                G[p] = greeksFromLevels(V[0][p], V1, nullptr);
+                continue;
+            }
+            double V2[3] = { V[2][p], 0.5 * (V[2][P + p] + V[2][2 * P + p]), V[2][3 * P + p] };
+            G[p] = greeksFromLevels(V[0][p], V1, V2);
+        }
+        return G;
+    }
+
+    double AsianBook::price() const {
+        std::vector<double> P = prices();
+        double total = 0.0;
+        for (int p = 0; p < size(); ++p)
+            total += products_[p].quantity * P[p];
+        return total;
+    }
+
+    AsianBook::Greeks AsianBook::greeks() const {
+        Greeks total = { 0.0, 0.0, 0.0, 0.0 };
+        std::vector<Greeks> G = productGreeks();
+        for (int p = 0; p < size(); ++p) {
+            total.price += products_[p].quantity * G[p].price;
+            total.delta += products_[p].quantity * G[p].delta;
+            total.gamma += products_[p].quantity * G[p].gamma;
+            total.theta += products_[p].quantity * G[p].theta;
+        }
+        return total;
+    }
+
+} // namespace crr
@@ -0,0 +1,112 @@
+#ifndef ASIANBOOK_H
+#define ASIANBOOK_H
+
+#include "Option.h"
+#include "Aggregator.h"
+#include "Payoff.h"
+#include <memory>
+#include <vector>
+
+namespace crr {
+
+    /**
+     * @brief Livre d’options path-dépendantes sur un même sous-jacent, valorisées en un seul
+     *        parcours de l’arbre non recombinant.
+     * @details Chaque trajectoire porte l’état de chaque agrégateur distinct du livre (un par
+     *          type : deux produits sur la moyenne arithmétique partagent le même état), et
+     *          chaque produit lit la valeur finale de son agrégateur. Le parcours est celui de
+     *          Asian::price() : sous-arbres en profondeur, répartis entre les threads. Les
+     *          leafLevels derniers niveaux de chaque sous-arbre sont traités par blocs de
+     *          2^leafLevels trajectoires (Aggregator::updatePaths, Aggregator::finalizePaths,
+     *          opt::Payoff::evaluate). Pour chaque produit, les valeurs sont identiques au bit
+     *          près à celles de Asian avec le même payoff et le même agrégateur, tant que le
+     *          compilateur ne contracte pas les produits-sommes en FMA (défaut de MSVC).
+     *          Leisen-Reimer se centre sur le strike du premier produit si Settings::strike vaut 0.
+     */
+    class AsianBook : public Option {
+    public:
+        /**
+         * @brief Un produit du livre.
+         */
+        struct Product {
+            std::shared_ptr<const opt::Payoff> payoff;    ///< Payoff appliqué à la valeur agrégée.
+            std::shared_ptr<const Aggregator> aggregator; ///< Agrégation des prix de la trajectoire.
+            double quantity = 1.0;                        ///< Quantité détenue.
+        };
+
+    private:
+        static const int leafLevels = 10;  ///< Niveaux traités par blocs au bas de chaque sous-arbre
+
+        std::vector<Product> products_;
+        std::vector<const Aggregator*> aggregators_;  ///< Agrégateurs distincts (un par type)
+        std::vector<int> slot_;                       ///< Indice dans aggregators_ de chaque produit
+
+        static double firstStrike(const std::vector<Product>& products);
+
+        /**
+         * @brief Tampons d’un parcours : pile des états, pile des valeurs et blocs des feuilles.
+         */
+        struct Workspace {
+            std::vector<double> state, value, S, blockState, average, blockValue;
+        };
+
+        /**
+         * @brief Valeurs des produits au nœud du niveau n, parcouru en profondeur.
+         * @param S     Prix du sous-jacent au nœud.
+         * @param depth Profondeur dans la pile de ws (états en depth A, valeurs en depth P).
+         * @param ws    Tampons du parcours.
+         */
+        void subtreeValues(int n, double S, int depth, Workspace& ws) const;
+
+        /**
+         * @brief Valeurs des produits au nœud du niveau n, par blocs sur les N - n derniers niveaux.
+         */
+        void blockValues(int n, double S, const double* state, double* value, Workspace& ws) const;
+
+        /**
+         * @brief Niveaux 0 à au moins min(levels, N) des valeurs, nœud j du niveau n en V[n][j P + p].
+         */
+        std::vector<std::vector<double>> topLevels(int levels) const;
+
+    public:
+        /**
+         * @param products Produits du livre (au moins un).
+         * @param settings Paramètres numériques (paramétrisation, threads).
+         */
+        AsianBook(double S0, double R, double sigma, double T, int N, const std::vector<Product>& products,
+            const Settings& settings = Settings());
+
+        /**
+         * @brief Nombre de produits du livre.
+         */
+        int size() const { return static_cast<int>(products_.size()); }
+
+        /**
+         * @brief Nombre d’états agrégés portés par chaque trajectoire.
+         */
+        int aggregatorCount() const { return static_cast<int>(aggregators_.size()); }
+
+        /**
+         * @brief Prix de chaque produit, dans l’ordre donné.
+         */
+        std::vector<double> prices() const;
+
+        /**
+         * @brief Sensibilités de chaque produit, lues sur les niveaux 0 à 2 comme Asian::greeks().
+         */
+        std::vector<Greeks> productGreeks() const;
+
+        /**
+         * @brief Valeur du livre : somme des prix pondérés par les quantités.
+         */
+        double price() const override;
+
+        /**
+         * @brief Sensibilités du livre : somme des sensibilités pondérées par les quantités.
+         */
+        Greeks greeks() const override;
+    };
+
+} // namespace crr
+
+#endif // ASIANBOOK_H
@@ -0,0 +1,249 @@
+#ifndef ASIANHULLWHITE_H
+#define ASIANHULLWHITE_H
+
+#include "Option.h"
+#include "StockTree.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace crr {
+
+    /**
+     * @brief Option path-dépendante sur l’arbre recombinant, par moyennes représentatives (Hull-White).
+     * @details Chaque nœud (n, i) porte M moyennes équidistantes. Pour chacune, la rétropropagation
+     *          agrège le prix des deux fils et lit leur valeur par interpolation linéaire entre leurs
+     *          moyennes représentatives. Temps O(N² M), mémoire O(N²) pour les grilles et O(N M)
+     *          pour les valeurs.
+     *
+     *          Les moyennes atteignables au nœud (n, i) vont de celle de la trajectoire baisses
+     *          puis hausses à celle de la trajectoire hausses puis baisses (l’agrégateur étant
+     *          croissant en chaque prix), un intervalle qui s’élargit comme sqrt(N) mais dont les
+     *          extrémités sont très improbables. Sachant le nœud, les C(n, i) trajectoires sont
+     *          équiprobables : le nœud parent est (n - 1, i - 1) avec probabilité i / n. Une passe
+     *          avant propage ainsi la moyenne et la variance de l’agrégat (linéarisé), et la grille
+     *          couvre moyenne ± 6 écarts-types, bornée par les moyennes atteignables ; au-delà,
+     *          la valeur est celle de la moyenne extrême de la grille. L’interpolation est cubique
+     *          (Lagrange sur quatre moyennes) : linéaire, répétée à chaque pas, elle surestimerait
+     *          les payoffs convexes d’une erreur croissant avec N / M. Pour N = 500, M = 50 suffit
+     *          à rester sous l’erreur de discrétisation de l’arbre.
+     * @tparam TPayoff     Type de payoff.
+     * @tparam TAggregator Type d'agrégateur (Arithmetic, Geometric, LookMax ou LookMin).
+     */
+    template<typename TPayoff, typename TAggregator>
+    class AsianHullWhite : public Option {
+    private:
+        TPayoff payoff_;
+        TAggregator aggregator_;
+        int M_;                        ///< Nombre de moyennes représentatives par nœud
+        StockTree stockTree_;
+        TriangularLattice lowest_;     ///< Plus petite moyenne représentée au nœud (n, i)
+        TriangularLattice step_;       ///< Écart entre deux moyennes représentatives (0 : une seule)
+
+        /**
+         * @brief Grilles des moyennes, niveau par niveau à partir des nœuds parents.
+         */
+        void buildGrids();
+
+        /**
+         * @brief k-ième moyenne représentative du nœud (n, i).
+         */
+        double average(int n, int i, int k) const { return lowest_(n, i) + k * step_(n, i); }
+
+        /**
+         * @brief Valeur interpolée pour la moyenne A sur une grille lo + k h, k = 0..M - 1.
+         * @param V Les M valeurs du nœud.
+         */
+        double interpolate(const double* V, double lo, double h, double A) const;
+
+        /**
+         * @brief Valeurs du niveau N : payoff de chaque moyenne représentative.
+         */
+        AlignedVector terminalValues() const;
+
+        /**
+         * @brief Rétropropagation du niveau from au niveau to.
+         * @param V       Niveau from en entrée ((from + 1) M valeurs), niveau to en sortie.
+         * @param scratch Tampon de même taille que V.
+         */
+        void induction(AlignedVector& V, AlignedVector& scratch, int from, int to) const;
+
+        /**
+         * @brief Valeur au nœud (n, i) après la trajectoire de prix path[0..n].
+         * @param V Niveau n.
+         */
+        double pathValue(const AlignedVector& V, int n, int i, const double* path) const;
+
+    public:
+        /**
+         * @param M Nombre de moyennes représentatives par nœud (au moins 2).
+         */
+        AsianHullWhite(double S0, double R, double sigma, double T, int N, const TPayoff& payoff,
+            const TAggregator& aggregator, int M = 100, const Settings& settings = Settings());
+
+        /**
+         * @brief Prix initial, deux niveaux de (N + 1) M valeurs en mémoire.
+         */
+        double price() const override;
+
+        /**
+         * @brief Sensibilités lues sur les niveaux 0 à 2, aux moyennes des trajectoires qui y mènent.
+         * @details Comme pour Asian, la valeur du nœud (2, 1) est la moyenne de celles des deux
+         *          trajectoires hausse-baisse et baisse-hausse.
+         */
+        Greeks greeks() const override;
+
+        /**
+         * @brief Nombre de moyennes représentatives par nœud.
+         */
+        int averages() const { return M_; }
+    };
+
+    template<typename TPayoff, typename TAggregator>
+    AsianHullWhite<TPayoff, TAggregator>::AsianHullWhite(double S0, double R, double sigma, double T, int N,
+        const TPayoff& payoff, const TAggregator& aggregator, int M, const Settings& settings)
+        : Option(S0, R, sigma, T, N, settings, payoff.strike()), payoff_(payoff), aggregator_(aggregator), M_(M),
+          stockTree_(S0_, u_, d_, N_, settings_.storage)
+    {
+        if (M_ < 2)
+            throw std::invalid_argument("Le nombre de moyennes M doit être >= 2");
+        buildGrids();
+    }
+
+    template<typename TPayoff, typename TAggregator>
+    void AsianHullWhite<TPayoff, TAggregator>::buildGrids() {
+        // Bornes : lo par la trajectoire baisses puis hausses (dernier pas vers (n, i) en hausse si
+        // i > 0), hi par hausses puis baisses (dernier pas en baisse si i < n).
+        // Moments : mélange des deux parents, de poids i / n et (n - i) / n.
+        const double band = 6.0;  // demi-largeur de la grille en écarts-types
+        std::vector<double> lo(1, S0_), hi(1, S0_), mean(1, S0_), var(1, 0.0);
+        lowest_ = TriangularLattice(N_ + 1);
+        step_ = TriangularLattice(N_ + 1);
+        lowest_(0, 0) = S0_;
+        for (int n = 1; n <= N_; ++n) {
+            std::vector<double> lo2(n + 1), hi2(n + 1), mean2(n + 1), var2(n + 1);
+            for (int i = 0; i <= n; ++i) {
+                double S = stockTree_(n, i);
+                lo2[i] = aggregator_(lo[i > 0 ? i - 1 : 0], S, n);
+                hi2[i] = aggregator_(hi[i < n ? i : n - 1], S, n);
+
+                double m1 = 0.0, m2 = 0.0;
+                auto parent = [&](int j, double w) {
+                    double eps = 1e-7 * std::max<double>(std::fabs(mean[j]), 1.0);
+                    double g = (aggregator_(mean[j] + eps, S, n) - aggregator_(mean[j] - eps, S, n)) / (2.0 * eps);
+                    double m = aggregator_(mean[j], S, n);
+                    m1 += w * m;
+                    m2 += w * (m * m + g * g * var[j]);
+                };
+                if (i > 0)
+                    parent(i - 1, double(i) / n);
+                if (i < n)
+                    parent(i, double(n - i) / n);
+                mean2[i] = m1;
+                var2[i] = std::max<double>(m2 - m1 * m1, 0.0);
+
+                double sd = std::sqrt(var2[i]);
+                double a = std::max<double>(lo2[i], m1 - band * sd);
+                double b = std::min<double>(hi2[i], m1 + band * sd);
+                lowest_(n, i) = a;
+                step_(n, i) = b > a ? (b - a) / (M_ - 1) : 0.0;
+            }
+            lo.swap(lo2);
+            hi.swap(hi2);
+            mean.swap(mean2);
+            var.swap(var2);
+        }
+    }
+
+    template<typename TPayoff, typename TAggregator>
+    double AsianHullWhite<TPayoff, TAggregator>::interpolate(const double* V, double lo, double h, double A) const {
+        if (!(h > 0.0))
+            return V[0];
+        double x = (A - lo) / h;
+        x = std::min<double>(std::max<double>(x, 0.0), M_ - 1);
+        if (M_ < 4) {
+            int k = std::min<int>(static_cast<int>(x), M_ - 2);
+            return V[k] + (V[k + 1] - V[k]) * (x - k);
+        }
+        // Lagrange cubique sur les moyennes k - 1 à k + 2, décentré aux bords
+        int k = std::min<int>(std::max<int>(static_cast<int>(x) - 1, 0), M_ - 4);
+        double t = x - k;
+        double l0 = -(t - 1.0) * (t - 2.0) * (t - 3.0) / 6.0;
+        double l1 = t * (t - 2.0) * (t - 3.0) / 2.0;
+        double l2 = -t * (t - 1.0) * (t - 3.0) / 2.0;
+        double l3 = t * (t - 1.0) * (t - 2.0) / 6.0;
+        return l0 * V[k] + l1 * V[k + 1] + l2 * V[k + 2] + l3 * V[k + 3];
+    }
+
+    template<typename TPayoff, typename TAggregator>
+    AlignedVector AsianHullWhite<TPayoff, TAggregator>::terminalValues() const {
+        AlignedVector V(std::size_t(N_ + 1) * M_);
+        for (int i = 0; i <= N_; ++i) {
+            for (int k = 0; k < M_; ++k)
+                V[std::size_t(i) * M_ + k] = payoff_(average(N_, i, k));
+        }
+        return V;
+    }
+
+    template<typename TPayoff, typename TAggregator>
+    void AsianHullWhite<TPayoff, TAggregator>::induction(AlignedVector& V, AlignedVector& scratch, int from, int to) const {
+        for (int n = from - 1; n >= to; --n) {
+            for (int i = 0; i <= n; ++i) {
+                double Su = stockTree_(n + 1, i + 1), Sd = stockTree_(n + 1, i);
+                double lo = lowest_(n, i), h = step_(n, i);
+                double loU = lowest_(n + 1, i + 1), hU = step_(n + 1, i + 1);
+                double loD = lowest_(n + 1, i), hD = step_(n + 1, i);
+                const double* Vu = V.data() + std::size_t(i + 1) * M_;
+                const double* Vd = V.data() + std::size_t(i) * M_;
+                double* W = scratch.data() + std::size_t(i) * M_;
+                for (int k = 0; k < M_; ++k) {
+                    double A = lo + k * h;
+                    W[k] = pu_ * interpolate(Vu, loU, hU, aggregator_(A, Su, n + 1))
+                         + pd_ * interpolate(Vd, loD, hD, aggregator_(A, Sd, n + 1));
+                }
+            }
+            V.swap(scratch);
+        }
+    }
+
+    template<typename TPayoff, typename TAggregator>
+    double AsianHullWhite<TPayoff, TAggregator>::pathValue(const AlignedVector& V, int n, int i, const double* path) const {
+        double A = path[0];
+        for (int m = 1; m <= n; ++m)
+            A = aggregator_(A, path[m], m);
+        return interpolate(V.data() + std::size_t(i) * M_, lowest_(n, i), step_(n, i), A);
+    }
+
+    template<typename TPayoff, typename TAggregator>
+    double AsianHullWhite<TPayoff, TAggregator>::price() const {
+        AlignedVector V = terminalValues(), scratch(V.size());
+        induction(V, scratch, N_, 0);
+        return V[0];
+    }
+
+    template<typename TPayoff, typename TAggregator>
+    typename AsianHullWhite<TPayoff, TAggregator>::Greeks AsianHullWhite<TPayoff, TAggregator>::greeks() const {
+        AlignedVector V = terminalValues(), scratch(V.size());
+        double S0 = S0_, Su = stockTree_(1, 1), Sd = stockTree_(1, 0);
+        double V2[3];
+        if (N_ >= 2) {
+            induction(V, scratch, N_, 2);
+            double Suu = stockTree_(2, 2), Sud = stockTree_(2, 1), Sdd = stockTree_(2, 0);
+            double dd[3] = { S0, Sd, Sdd }, du[3] = { S0, Sd, Sud }, ud[3] = { S0, Su, Sud }, uu[3] = { S0, Su, Suu };
+            V2[0] = pathValue(V, 2, 0, dd);
+            V2[1] = 0.5 * (pathValue(V, 2, 1, du) + pathValue(V, 2, 1, ud));
+            V2[2] = pathValue(V, 2, 2, uu);
+            induction(V, scratch, 2, 1);
+        }
+        else {
+            induction(V, scratch, N_, 1);
+        }
+        double d[2] = { S0, Sd }, u[2] = { S0, Su };
+        double V1[2] = { pathValue(V, 1, 0, d), pathValue(V, 1, 1, u) };
+        induction(V, scratch, 1, 0);
+        return greeksFromLevels(V[0], V1, N_ >= 2 ? V2 : nullptr);
+    }
+
+} // namespace crr
+
+#endif // ASIANHULLWHITE_H
@@ -2,6 +2,10 @@
 #define EUROPEAN_H
 
 #include "Option.h"
+#include "StockTree.h"
+#include "TerminalDistribution.h"
+#include "Kernels.h"
+#include "Tiling.h"
 
 namespace crr {
 
@@ -13,71 +17,199 @@ namespace crr {
     class European : public Option {
     private:
         TPayoff payoff_;
-        std::vector<std::vector<double>> stockTree_;  ///< Arbre binomiale recombinant des prix du sous-jacent
-        void buildStockTree();                        ///< Génère l’arbre binomial recombinant des prix du sous-jacent
+        StockTree stockTree_;  ///< Arbre binomiale recombinant des prix du sous-jacent
+
+        /**
+         * @brief Payoffs à l’échéance (N + 1 valeurs).
+         */
+        AlignedVector terminalValues() const;
+
+        /**
+         * @brief Lissage BBS : remplace le niveau N par les valeurs de Black-Scholes sur un pas au niveau N - 1.
+         */
+        void smooth(AlignedVector& V) const;
+
+        /**
+         * @brief Rétropropagation en place du niveau from au niveau to.
+         * @param V Niveau from en entrée ; V[0..to] contient le niveau to en sortie.
+         */
+        void induction(AlignedVector& V, int from, int to) const;
 
     public:
-        European(double S0, double R, double sigma, double T, int N, const TPayoff& payoff);
-        std::vector<std::vector<double>> treePrice() const override;
-        HedgingStrategy hedgingStrategy() const override;
+        using Hedging = HedgingStrategy<TriangularLattice>;
+
+        European(double S0, double R, double sigma, double T, int N, const TPayoff& payoff,
+            const Settings& settings = Settings());
+        TriangularLattice treePrice() const;
+        Hedging hedgingStrategy() const;
+
+        /**
+         * @brief Stratégie de couverture transmise niveau par niveau, de N - 1 à 0.
+         * @details Valeurs, deltas et obligations sont calculés en une seule rétropropagation ;
+         *          seuls deux niveaux restent en mémoire (O(N) au lieu de trois treillis en
+         *          O(N²)), le visiteur pouvant par exemple écrire chaque niveau sur disque.
+         *          Mêmes valeurs que hedgingStrategy(), au bit près.
+         * @param visit Appelé avec un const HedgingLevel& pour chaque niveau.
+         */
+        template<typename TVisitor>
+        void visitHedgingStrategy(TVisitor&& visit) const;
+
+        Greeks greeks() const override;
+
+        /**
+         * @brief Prix initial sans construire l’arbre des valeurs.
+         * @details Rétropropagation en place dans un unique tampon de N+1 valeurs, pavée dans le
+         *          temps si Settings::tileWidth > 0, répartie sur Settings::threads threads pour
+         *          les niveaux d’au moins Settings::parallelCutoff nœuds (mêmes résultats au bit près).
+         * @return Valeur de l’option à n = 0, identique à treePrice()(0, 0) sans lissage.
+         */
+        double price() const override;
+
+        /**
+         * @brief Distribution terminale actualisée de l’arbre (partagée et mise en cache).
+         * @details Permet de valoriser d’autres payoffs européens sur le même arbre en O(N)
+         *          chacun, par exemple toute une gamme de strikes.
+         */
+        std::shared_ptr<const TerminalDistribution> terminalDistribution() const;
     };
 
     template<typename TPayoff>
     European<TPayoff>::European(double S0, double R, double sigma,
-        double T, int N, const TPayoff& payoff)
-        : Option(S0, R, sigma, T, N), payoff_(payoff)
+        double T, int N, const TPayoff& payoff, const Settings& settings)
+        : Option(S0, R, sigma, T, N, settings, payoff.strike()), payoff_(payoff),
+          stockTree_(S0_, u_, d_, N_, settings_.storage)
     {
-        buildStockTree();
     }
 
     template<typename TPayoff>
-    void European<TPayoff>::buildStockTree() {
-        stockTree_.assign(N_ + 1, {});
-        for (int n = 0; n <= N_; ++n) {
-            stockTree_[n].resize(n + 1);
-            for (int i = 0; i <= n; ++i) {
-                stockTree_[n][i] = S0_ * std::pow(1 + u_, i) * std::pow(1 + d_, n - i);
-            }
+    TriangularLattice European<TPayoff>::treePrice() const {
+        TriangularLattice V(N_ + 1);
+        AlignedVector scratch(N_ + 1);
+        // Valeurs terminales
+        auto VN = V[N_];
+        const double* SN = stockTree_.level(N_, scratch.data());
+        payoff_.evaluate(SN, VN.data(), N_ + 1);
+
+        // Rétropropagation 
+        for (int n = N_ - 1; n >= 0; --n)
+            simd::step(V[n + 1].data(), V[n].data(), n + 1, pu_, pd_);
+        return V;
+    }
+
+    template<typename TPayoff>
+    AlignedVector European<TPayoff>::terminalValues() const {
+        AlignedVector V(N_ + 1);
+        payoff_.evaluate(stockTree_.level(N_, V.data()), V.data(), N_ + 1);
+        return V;
+    }
+
+    template<typename TPayoff>
+    void European<TPayoff>::smooth(AlignedVector& V) const {
+        double dt = T_ / N_;
+        const double* S = stockTree_.level(N_ - 1, V.data());
+        for (int i = 0; i < N_; ++i)
+            V[i] = payoff_.blackScholes(S[i], R_, sigma_, dt);
+    }
+
+    template<typename TPayoff>
+    void European<TPayoff>::induction(AlignedVector& V, int from, int to) const {
+        int top = from;
+        if (settings_.threads != 1) {
+            top = parallelInduction(V.data(), from, to, settings_, [&](int, int, int, int count, double* W) {
+                simd::rollback(W, count, pu_, pd_);
+            });
+        }
+
+        // V[i] n'est plus lu une fois le niveau n calculé : mise à jour en place
+        if (settings_.tileWidth > 0) {
+            tiledInduction(top, to, settings_.tileWidth, settings_.tileLevels, [&](int, int i0, int count) {
+                simd::rollback(V.data() + i0, count, pu_, pd_);
+            });
+        }
+        else {
+            for (int n = top - 1; n >= to; --n)
+                simd::rollback(V.data(), n + 1, pu_, pd_);
         }
     }
 
     template<typename TPayoff>
-    std::vector<std::vector<double>> European<TPayoff>::treePrice() const {
-        std::vector<std::vector<double>> V(N_ + 1);
-        V[N_].resize(N_ + 1);
-        // Valeurs terminales
-        for (int i = 0; i <= N_; ++i)
-            V[N_][i] = payoff_(stockTree_[N_][i]);
+    double European<TPayoff>::price() const {
+        AlignedVector V = terminalValues();
+        int level = N_;
+        if (smoothsLastStep()) {
+            smooth(V);
+            --level;
+        }
+        induction(V, level, 0);
+        return V[0];
+    }
 
-        // Rétropropagation 
-        for (int n = N_ - 1; n >= 0; --n) {
-            V[n].resize(n + 1);
-            for (int i = 0; i <= n; ++i) {
-                V[n][i] = discount_ * 0.5 * (V[n + 1][i + 1] + V[n + 1][i]);
-            }
+    template<typename TPayoff>
+    typename European<TPayoff>::Greeks European<TPayoff>::greeks() const {
+        // Niveaux 0 à 2 relevés au passage ; avec le lissage, le niveau N reste le payoff
+        double L[3][3];
+        AlignedVector V = terminalValues();
+        auto save = [&](int n) {
+            if (n <= 2)
+                std::copy(V.begin(), V.begin() + n + 1, L[n]);
+        };
+        int level = N_;
+        save(level);
+        if (smoothsLastStep()) {
+            smooth(V);
+            save(--level);
         }
-        return V;
+        if (level > 2) {
+            induction(V, level, 2);
+            level = 2;
+            save(level);
+        }
+        for (; level > 0; --level) {
+            induction(V, level, level - 1);
+            save(level - 1);
+        }
+        return greeksFromLevels(L[0][0], L[1], N_ >= 2 ? L[2] : nullptr);
+    }
+
+    template<typename TPayoff>
+    std::shared_ptr<const TerminalDistribution> European<TPayoff>::terminalDistribution() const {
+        return TerminalDistribution::get(S0_, u_, d_, discount_, p_, N_);
     }
 
     template<typename TPayoff>
-    Option::HedgingStrategy European<TPayoff>::hedgingStrategy() const {
-        auto V = treePrice();
-        HedgingStrategy H;
-        H.delta.resize(N_);
-        H.bond.resize(N_);
-        for (int n = 0; n < N_; ++n) {
-            H.delta[n].resize(n + 1);
-            H.bond[n].resize(n + 1);
+    template<typename TVisitor>
+    void European<TPayoff>::visitHedgingStrategy(TVisitor&& visit) const {
+        // Niveaux n et n + 1 en alternance selon la parité de n
+        AlignedVector Vbuf[2] = { AlignedVector(N_ + 1), AlignedVector(N_ + 1) };
+        AlignedVector Sbuf[2] = { AlignedVector(N_ + 1), AlignedVector(N_ + 1) };
+        AlignedVector delta(N_), bond(N_);
+
+        double* Vnext = Vbuf[N_ & 1].data();
+        const double* Snext = stockTree_.level(N_, Sbuf[N_ & 1].data());
+        payoff_.evaluate(Snext, Vnext, N_ + 1);
+
+        for (int n = N_ - 1; n >= 0; --n) {
+            double* V = Vbuf[n & 1].data();
+            const double* S = stockTree_.level(n, Sbuf[n & 1].data());
+            simd::step(Vnext, V, n + 1, pu_, pd_);
             for (int i = 0; i <= n; ++i) {
-                double Vu = V[n + 1][i + 1];
-                double Vd = V[n + 1][i];
-                double Su = stockTree_[n + 1][i + 1];
-                double Sd = stockTree_[n + 1][i];
-                double dlt = (Vu - Vd) / (Su - Sd);
-                H.delta[n][i] = dlt;
-                H.bond[n][i] = V[n][i] - dlt * stockTree_[n][i];
+                double dlt = (Vnext[i + 1] - Vnext[i]) / (Snext[i + 1] - Snext[i]);
+                delta[i] = dlt;
+                bond[i] = V[i] - dlt * S[i];
             }
+            visit(HedgingLevel{ n, n + 1, S, V, delta.data(), bond.data() });
+            Vnext = V;
+            Snext = S;
         }
+    }
+
+    template<typename TPayoff>
+    typename European<TPayoff>::Hedging European<TPayoff>::hedgingStrategy() const {
+        Hedging H{ TriangularLattice(N_), TriangularLattice(N_) };
+        visitHedgingStrategy([&](const HedgingLevel& level) {
+            std::copy(level.delta, level.delta + level.size, H.delta[level.n].begin());
+            std::copy(level.bond, level.bond + level.size, H.bond[level.n].begin());
+        });
         return H;
     }
 
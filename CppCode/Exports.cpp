@@ -43,6 +43,11 @@ extern "C" VARIANT __stdcall name args {                 \
 
 static bool g_errorDisplayed = false;
 
+/**
+ * @brief Paramètres numériques communs à tous les moteurs d’arbres appelés depuis Excel.
+ */
+static crr::Settings g_settings;
+
 extern "C" __declspec(dllexport) void __stdcall ResetErrorFlag()
 {
     g_errorDisplayed = false;
@@ -112,24 +117,140 @@ VARIANT toVariant(const Mtx& matrix) {
     return makeVariantFromArray(psa);
 }
 
+/**
+ * @brief Convertit un treillis triangulaire contigu en VARIANT COM.
+ * @param lattice Treillis dont chaque niveau devient une colonne du SAFEARRAY.
+ * @return VARIANT contenant un SAFEARRAY carré (niveaux × niveaux) de doubles.
+ */
+VARIANT toVariant(const crr::TriangularLattice& lattice) {
+    int levels = lattice.size();
+
+    SAFEARRAYBOUND sab[2];
+    sab[0].lLbound = 0; sab[0].cElements = levels;
+    sab[1].lLbound = 0; sab[1].cElements = levels;
+    SAFEARRAY* psa = SafeArrayCreate(VT_R8, 2, sab);
+
+    double* data = nullptr;
+    SafeArrayAccessData(psa, (void**)&data);
+    for (int n = 0; n < levels; ++n) {
+        const double* row = lattice[n].data();
+        double* col = data + n * levels;
+        for (int i = 0; i <= n; ++i)
+            col[i] = row[i];
+    }
+    SafeArrayUnaccessData(psa);
+    return makeVariantFromArray(psa);
+}
+
+/**
+ * @brief Convertit des colonnes de doubles en VARIANT COM, les NaN devenant #N/A.
+ * @param columns Colonnes de même longueur, chacune devenant une colonne du SAFEARRAY.
+ * @return VARIANT contenant un SAFEARRAY bidimensionnel de VARIANT : doubles, ou erreur
+ *         CVErr(xlErrNA) à la place des NaN, qu’Excel affiche #N/A.
+ */
+VARIANT toVariantNA(const std::vector<std::vector<double>>& columns) {
+    const SCODE errorNA = static_cast<SCODE>(0x800A07FA);  // xlErrNA (2042) encodé par VBA
+    int cols = int(columns.size());
+    int rows = cols > 0 ? int(columns[0].size()) : 0;
+
+    SAFEARRAYBOUND sab[2];
+    sab[0].lLbound = 0; sab[0].cElements = rows;
+    sab[1].lLbound = 0; sab[1].cElements = cols;
+    SAFEARRAY* psa = SafeArrayCreate(VT_VARIANT, 2, sab);
+
+    VARIANT* data = nullptr;
+    SafeArrayAccessData(psa, (void**)&data);
+    for (int n = 0; n < cols; ++n) {
+        for (int i = 0; i < rows; ++i) {
+            VARIANT& cell = data[i + n * rows];
+            if (std::isnan(columns[n][i])) {
+                cell.vt = VT_ERROR;
+                cell.scode = errorNA;
+            }
+            else {
+                cell.vt = VT_R8;
+                cell.dblVal = columns[n][i];
+            }
+        }
+    }
+    SafeArrayUnaccessData(psa);
+
+    VARIANT var;
+    VariantInit(&var);
+    var.vt = VT_ARRAY | VT_VARIANT;
+    var.parray = psa;
+    return var;
+}
+
+//=============================================================================
+// Paramètres
+//=============================================================================
+
+SAFE_DOUBLE(SetParameterization,
+    (int kind),
+    if (kind < int(crr::Parameterization::Classic) || kind > int(crr::Parameterization::LeisenReimer))
+        throw std::invalid_argument("Paramétrisation inconnue (0 à 4)");
+    g_settings.parameterization = crr::Parameterization(kind);
+    return kind;
+)
+
+SAFE_DOUBLE(SetSmoothing,
+    (int mode),
+    if (mode < int(crr::Smoothing::None) || mode > int(crr::Smoothing::BBSR))
+        throw std::invalid_argument("Lissage inconnu (0 à 2)");
+    g_settings.smoothing = crr::Smoothing(mode);
+    return mode;
+)
+
+SAFE_DOUBLE(SetThreads,
+    (int threads),
+    if (threads < 0)
+        throw std::invalid_argument("Le nombre de threads doit être >= 0");
+    g_settings.threads = threads;
+    return crr::threadCount(threads);
+)
+
+SAFE_DOUBLE(SetMonteCarlo,
+    (int steps, int paths, int seed),
+    if (steps < 1 || paths < 1)
+        throw std::invalid_argument("Les nombres de pas et de trajectoires doivent être >= 1");
+    g_settings.mcSteps = steps;
+    g_settings.mcPaths = paths;
+    g_settings.mcSeed = std::uint64_t(std::uint32_t(seed));
+    if (g_settings.mcSampling == crr::Sampling::Sobol && paths >= g_settings.mcReplicates)
+        return crr::MonteCarlo::sobolPaths(paths, g_settings.mcReplicates);
+    return paths;
+)
+
+SAFE_DOUBLE(SetSampling,
+    (int mode, int replicates),
+    if (mode < int(crr::Sampling::PseudoRandom) || mode > int(crr::Sampling::Sobol))
+        throw std::invalid_argument("Tirages inconnus (0 à 1)");
+    if (replicates < 1)
+        throw std::invalid_argument("Le nombre de répétitions doit être >= 1");
+    g_settings.mcSampling = crr::Sampling(mode);
+    g_settings.mcReplicates = replicates;
+    return mode;
+)
+
 //=============================================================================
 // Vanilla Call
 //=============================================================================
 
 SAFE_DOUBLE(PriceEuCall,
     (double S0, double R, double sigma, double T, int N, double K),
-    return crr::European<opt::PayoffCall>(S0, R, sigma, T, N, opt::PayoffCall(K)).price();
+    return crr::European<opt::PayoffCall>(S0, R, sigma, T, N, opt::PayoffCall(K), g_settings).price();
 )
 
 SAFE_DOUBLE(DeltaEuCall,
     (double S0, double R, double sigma, double T, int N, double K),
-    return crr::European<opt::PayoffCall>(S0, R, sigma, T, N, opt::PayoffCall(K)).deltaZero();
+    return crr::European<opt::PayoffCall>(S0, R, sigma, T, N, opt::PayoffCall(K), g_settings).deltaZero();
 )
 
 SAFE_VARIANT(TreeEuCall,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto V = crr::European<opt::PayoffCall>(S0, R, sigma, T, N, opt::PayoffCall(K)).treePrice();
+        auto V = crr::European<opt::PayoffCall>(S0, R, sigma, T, N, opt::PayoffCall(K), g_settings).treePrice();
         return toVariant(V);                  
     }
 )
@@ -137,7 +258,7 @@ SAFE_VARIANT(TreeEuCall,
 SAFE_VARIANT(TreeDeltaEuCall,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto H = crr::European<opt::PayoffCall>(S0, R, sigma, T, N, opt::PayoffCall(K)).hedgingStrategy();
+        auto H = crr::European<opt::PayoffCall>(S0, R, sigma, T, N, opt::PayoffCall(K), g_settings).hedgingStrategy();
         return toVariant(H.delta);            
     }
 )
@@ -145,7 +266,7 @@ SAFE_VARIANT(TreeDeltaEuCall,
 SAFE_VARIANT(TreeBondEuCall,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto H = crr::European<opt::PayoffCall>(S0, R, sigma, T, N, opt::PayoffCall(K)).hedgingStrategy();
+        auto H = crr::European<opt::PayoffCall>(S0, R, sigma, T, N, opt::PayoffCall(K), g_settings).hedgingStrategy();
         return toVariant(H.bond);             
     }
 )
@@ -156,18 +277,18 @@ SAFE_VARIANT(TreeBondEuCall,
 
 SAFE_DOUBLE(PriceEuPut,
     (double S0, double R, double sigma, double T, int N, double K),
-    return crr::European<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K)).price();
+    return crr::European<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K), g_settings).price();
 )
 
 SAFE_DOUBLE(DeltaEuPut,
     (double S0, double R, double sigma, double T, int N, double K),
-    return crr::European<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K)).deltaZero();
+    return crr::European<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K), g_settings).deltaZero();
 )
 
 SAFE_VARIANT(TreeEuPut,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto V = crr::European<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K)).treePrice();
+        auto V = crr::European<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K), g_settings).treePrice();
         return toVariant(V);
     }
 )
@@ -175,7 +296,7 @@ SAFE_VARIANT(TreeEuPut,
 SAFE_VARIANT(TreeDeltaEuPut,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto H = crr::European<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K)).hedgingStrategy();
+        auto H = crr::European<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K), g_settings).hedgingStrategy();
         return toVariant(H.delta);
     }
 )
@@ -183,7 +304,7 @@ SAFE_VARIANT(TreeDeltaEuPut,
 SAFE_VARIANT(TreeBondEuPut,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto H = crr::European<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K)).hedgingStrategy();
+        auto H = crr::European<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K), g_settings).hedgingStrategy();
         return toVariant(H.bond);
     }
 )
@@ -194,18 +315,18 @@ SAFE_VARIANT(TreeBondEuPut,
 
 SAFE_DOUBLE(PriceDigitCall,
     (double S0, double R, double sigma, double T, int N, double K),
-    return crr::European<opt::PayoffDigitCall>(S0, R, sigma, T, N, opt::PayoffDigitCall(K)).price();
+    return crr::European<opt::PayoffDigitCall>(S0, R, sigma, T, N, opt::PayoffDigitCall(K), g_settings).price();
 )
 
 SAFE_DOUBLE(DeltaDigitCall,
     (double S0, double R, double sigma, double T, int N, double K),
-    return crr::European<opt::PayoffDigitCall>(S0, R, sigma, T, N, opt::PayoffDigitCall(K)).deltaZero();
+    return crr::European<opt::PayoffDigitCall>(S0, R, sigma, T, N, opt::PayoffDigitCall(K), g_settings).deltaZero();
 )
 
 SAFE_VARIANT(TreeDigitCall,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto V = crr::European<opt::PayoffDigitCall>(S0, R, sigma, T, N, opt::PayoffDigitCall(K)).treePrice();
+        auto V = crr::European<opt::PayoffDigitCall>(S0, R, sigma, T, N, opt::PayoffDigitCall(K), g_settings).treePrice();
         return toVariant(V);
     }
 )
@@ -213,7 +334,7 @@ SAFE_VARIANT(TreeDigitCall,
 SAFE_VARIANT(TreeDeltaDigitCall,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto H = crr::European<opt::PayoffDigitCall>(S0, R, sigma, T, N, opt::PayoffDigitCall(K)).hedgingStrategy();
+        auto H = crr::European<opt::PayoffDigitCall>(S0, R, sigma, T, N, opt::PayoffDigitCall(K), g_settings).hedgingStrategy();
         return toVariant(H.delta);
     }
 )
@@ -221,7 +342,7 @@ SAFE_VARIANT(TreeDeltaDigitCall,
 SAFE_VARIANT(TreeBondDigitCall,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto H = crr::European<opt::PayoffDigitCall>(S0, R, sigma, T, N, opt::PayoffDigitCall(K)).hedgingStrategy();
+        auto H = crr::European<opt::PayoffDigitCall>(S0, R, sigma, T, N, opt::PayoffDigitCall(K), g_settings).hedgingStrategy();
         return toVariant(H.bond);
     }
 )
@@ -232,18 +353,18 @@ SAFE_VARIANT(TreeBondDigitCall,
 
 SAFE_DOUBLE(PriceDigitPut,
     (double S0, double R, double sigma, double T, int N, double K),
-    return crr::European<opt::PayoffDigitPut>(S0, R, sigma, T, N, opt::PayoffDigitPut(K)).price();
+    return crr::European<opt::PayoffDigitPut>(S0, R, sigma, T, N, opt::PayoffDigitPut(K), g_settings).price();
 )
 
 SAFE_DOUBLE(DeltaDigitPut,
     (double S0, double R, double sigma, double T, int N, double K),
-    return crr::European<opt::PayoffDigitPut>(S0, R, sigma, T, N, opt::PayoffDigitPut(K)).deltaZero();
+    return crr::European<opt::PayoffDigitPut>(S0, R, sigma, T, N, opt::PayoffDigitPut(K), g_settings).deltaZero();
 )
 
 SAFE_VARIANT(TreeDigitPut,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto V = crr::European<opt::PayoffDigitPut>(S0, R, sigma, T, N, opt::PayoffDigitPut(K)).treePrice();
+        auto V = crr::European<opt::PayoffDigitPut>(S0, R, sigma, T, N, opt::PayoffDigitPut(K), g_settings).treePrice();
         return toVariant(V);
     }
 )
@@ -251,7 +372,7 @@ SAFE_VARIANT(TreeDigitPut,
 SAFE_VARIANT(TreeDeltaDigitPut,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto H = crr::European<opt::PayoffDigitPut>(S0, R, sigma, T, N, opt::PayoffDigitPut(K)).hedgingStrategy();
+        auto H = crr::European<opt::PayoffDigitPut>(S0, R, sigma, T, N, opt::PayoffDigitPut(K), g_settings).hedgingStrategy();
         return toVariant(H.delta);
     }
 )
@@ -259,7 +380,7 @@ SAFE_VARIANT(TreeDeltaDigitPut,
 SAFE_VARIANT(TreeBondDigitPut,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto H = crr::European<opt::PayoffDigitPut>(S0, R, sigma, T, N, opt::PayoffDigitPut(K)).hedgingStrategy();
+        auto H = crr::European<opt::PayoffDigitPut>(S0, R, sigma, T, N, opt::PayoffDigitPut(K), g_settings).hedgingStrategy();
         return toVariant(H.bond);
     }
 )
@@ -270,18 +391,18 @@ SAFE_VARIANT(TreeBondDigitPut,
 
 SAFE_DOUBLE(PriceDD,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
-    return crr::European<opt::PayoffDoubleDigit>(S0, R, sigma, T, N, opt::PayoffDoubleDigit(K1, K2)).price();
+    return crr::European<opt::PayoffDoubleDigit>(S0, R, sigma, T, N, opt::PayoffDoubleDigit(K1, K2), g_settings).price();
 )
 
 SAFE_DOUBLE(DeltaDD,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
-    return crr::European<opt::PayoffDoubleDigit>(S0, R, sigma, T, N, opt::PayoffDoubleDigit(K1, K2)).deltaZero();
+    return crr::European<opt::PayoffDoubleDigit>(S0, R, sigma, T, N, opt::PayoffDoubleDigit(K1, K2), g_settings).deltaZero();
 )
 
 SAFE_VARIANT(TreeDD,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
     {
-        auto V = crr::European<opt::PayoffDoubleDigit>(S0, R, sigma, T, N, opt::PayoffDoubleDigit(K1, K2)).treePrice();
+        auto V = crr::European<opt::PayoffDoubleDigit>(S0, R, sigma, T, N, opt::PayoffDoubleDigit(K1, K2), g_settings).treePrice();
         return toVariant(V);
     }
 )
@@ -289,7 +410,7 @@ SAFE_VARIANT(TreeDD,
 SAFE_VARIANT(TreeDeltaDD,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
     {
-        auto H = crr::European<opt::PayoffDoubleDigit>(S0, R, sigma, T, N, opt::PayoffDoubleDigit(K1, K2)).hedgingStrategy();
+        auto H = crr::European<opt::PayoffDoubleDigit>(S0, R, sigma, T, N, opt::PayoffDoubleDigit(K1, K2), g_settings).hedgingStrategy();
         return toVariant(H.delta);
     }
 )
@@ -297,7 +418,7 @@ SAFE_VARIANT(TreeDeltaDD,
 SAFE_VARIANT(TreeBondDD,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
     {
-        auto H = crr::European<opt::PayoffDoubleDigit>(S0, R, sigma, T, N, opt::PayoffDoubleDigit(K1, K2)).hedgingStrategy();
+        auto H = crr::European<opt::PayoffDoubleDigit>(S0, R, sigma, T, N, opt::PayoffDoubleDigit(K1, K2), g_settings).hedgingStrategy();
         return toVariant(H.bond);
     }
 )
@@ -308,18 +429,18 @@ SAFE_VARIANT(TreeBondDD,
 
 SAFE_DOUBLE(PriceBull,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
-    return crr::European<opt::PayoffBull>(S0, R, sigma, T, N, opt::PayoffBull(K1, K2)).price();
+    return crr::European<opt::PayoffBull>(S0, R, sigma, T, N, opt::PayoffBull(K1, K2), g_settings).price();
 )
 
 SAFE_DOUBLE(DeltaBull,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
-    return crr::European<opt::PayoffBull>(S0, R, sigma, T, N, opt::PayoffBull(K1, K2)).deltaZero();
+    return crr::European<opt::PayoffBull>(S0, R, sigma, T, N, opt::PayoffBull(K1, K2), g_settings).deltaZero();
 )
 
 SAFE_VARIANT(TreeBull,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
     {
-        auto V = crr::European<opt::PayoffBull>(S0, R, sigma, T, N, opt::PayoffBull(K1, K2)).treePrice();
+        auto V = crr::European<opt::PayoffBull>(S0, R, sigma, T, N, opt::PayoffBull(K1, K2), g_settings).treePrice();
         return toVariant(V);
     }
 )
@@ -327,7 +448,7 @@ SAFE_VARIANT(TreeBull,
 SAFE_VARIANT(TreeDeltaBull,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
     {
-        auto H = crr::European<opt::PayoffBull>(S0, R, sigma, T, N, opt::PayoffBull(K1, K2)).hedgingStrategy();
+        auto H = crr::European<opt::PayoffBull>(S0, R, sigma, T, N, opt::PayoffBull(K1, K2), g_settings).hedgingStrategy();
         return toVariant(H.delta);
     }
 )
@@ -335,7 +456,7 @@ SAFE_VARIANT(TreeDeltaBull,
 SAFE_VARIANT(TreeBondBull,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
     {
-        auto H = crr::European<opt::PayoffBull>(S0, R, sigma, T, N, opt::PayoffBull(K1, K2)).hedgingStrategy();
+        auto H = crr::European<opt::PayoffBull>(S0, R, sigma, T, N, opt::PayoffBull(K1, K2), g_settings).hedgingStrategy();
         return toVariant(H.bond);
     }
 )
@@ -346,18 +467,18 @@ SAFE_VARIANT(TreeBondBull,
 
 SAFE_DOUBLE(PriceBear,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
-    return crr::European<opt::PayoffBear>(S0, R, sigma, T, N, opt::PayoffBear(K1, K2)).price();
+    return crr::European<opt::PayoffBear>(S0, R, sigma, T, N, opt::PayoffBear(K1, K2), g_settings).price();
 )
 
 SAFE_DOUBLE(DeltaBear,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
-    return crr::European<opt::PayoffBear>(S0, R, sigma, T, N, opt::PayoffBear(K1, K2)).deltaZero();
+    return crr::European<opt::PayoffBear>(S0, R, sigma, T, N, opt::PayoffBear(K1, K2), g_settings).deltaZero();
 )
 
 SAFE_VARIANT(TreeBear,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
     {
-        auto V = crr::European<opt::PayoffBear>(S0, R, sigma, T, N, opt::PayoffBear(K1, K2)).treePrice();
+        auto V = crr::European<opt::PayoffBear>(S0, R, sigma, T, N, opt::PayoffBear(K1, K2), g_settings).treePrice();
         return toVariant(V);
     }
 )
@@ -365,7 +486,7 @@ SAFE_VARIANT(TreeBear,
 SAFE_VARIANT(TreeDeltaBear,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
     {
-        auto H = crr::European<opt::PayoffBear>(S0, R, sigma, T, N, opt::PayoffBear(K1, K2)).hedgingStrategy();
+        auto H = crr::European<opt::PayoffBear>(S0, R, sigma, T, N, opt::PayoffBear(K1, K2), g_settings).hedgingStrategy();
         return toVariant(H.delta);
     }
 )
@@ -373,7 +494,7 @@ SAFE_VARIANT(TreeDeltaBear,
 SAFE_VARIANT(TreeBondBear,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
     {
-        auto H = crr::European<opt::PayoffBear>(S0, R, sigma, T, N, opt::PayoffBear(K1, K2)).hedgingStrategy();
+        auto H = crr::European<opt::PayoffBear>(S0, R, sigma, T, N, opt::PayoffBear(K1, K2), g_settings).hedgingStrategy();
         return toVariant(H.bond);
     }
 )
@@ -384,18 +505,18 @@ SAFE_VARIANT(TreeBondBear,
 
 SAFE_DOUBLE(PriceStrangle,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
-    return crr::European<opt::PayoffStrangle>(S0, R, sigma, T, N, opt::PayoffStrangle(K1, K2)).price();
+    return crr::European<opt::PayoffStrangle>(S0, R, sigma, T, N, opt::PayoffStrangle(K1, K2), g_settings).price();
 )
 
 SAFE_DOUBLE(DeltaStrangle,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
-    return crr::European<opt::PayoffStrangle>(S0, R, sigma, T, N, opt::PayoffStrangle(K1, K2)).deltaZero();
+    return crr::European<opt::PayoffStrangle>(S0, R, sigma, T, N, opt::PayoffStrangle(K1, K2), g_settings).deltaZero();
 )
 
 SAFE_VARIANT(TreeStrangle,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
     {
-        auto V = crr::European<opt::PayoffStrangle>(S0, R, sigma, T, N, opt::PayoffStrangle(K1, K2)).treePrice();
+        auto V = crr::European<opt::PayoffStrangle>(S0, R, sigma, T, N, opt::PayoffStrangle(K1, K2), g_settings).treePrice();
         return toVariant(V);
     }
 )
@@ -403,7 +524,7 @@ SAFE_VARIANT(TreeStrangle,
 SAFE_VARIANT(TreeDeltaStrangle,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
     {
-        auto H = crr::European<opt::PayoffStrangle>(S0, R, sigma, T, N, opt::PayoffStrangle(K1, K2)).hedgingStrategy();
+        auto H = crr::European<opt::PayoffStrangle>(S0, R, sigma, T, N, opt::PayoffStrangle(K1, K2), g_settings).hedgingStrategy();
         return toVariant(H.delta);
     }
 )
@@ -411,7 +532,7 @@ SAFE_VARIANT(TreeDeltaStrangle,
 SAFE_VARIANT(TreeBondStrangle,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
     {
-        auto H = crr::European<opt::PayoffStrangle>(S0, R, sigma, T, N, opt::PayoffStrangle(K1, K2)).hedgingStrategy();
+        auto H = crr::European<opt::PayoffStrangle>(S0, R, sigma, T, N, opt::PayoffStrangle(K1, K2), g_settings).hedgingStrategy();
         return toVariant(H.bond);
     }
 )
@@ -422,18 +543,18 @@ SAFE_VARIANT(TreeBondStrangle,
 
 SAFE_DOUBLE(PriceButterfly,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
-    return crr::European<opt::PayoffButterfly>(S0, R, sigma, T, N, opt::PayoffButterfly(K1, K2)).price();
+    return crr::European<opt::PayoffButterfly>(S0, R, sigma, T, N, opt::PayoffButterfly(K1, K2), g_settings).price();
 )
 
 SAFE_DOUBLE(DeltaButterfly,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
-    return crr::European<opt::PayoffButterfly>(S0, R, sigma, T, N, opt::PayoffButterfly(K1, K2)).deltaZero();
+    return crr::European<opt::PayoffButterfly>(S0, R, sigma, T, N, opt::PayoffButterfly(K1, K2), g_settings).deltaZero();
 )
 
 SAFE_VARIANT(TreeButterfly,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
     {
-        auto V = crr::European<opt::PayoffButterfly>(S0, R, sigma, T, N, opt::PayoffButterfly(K1, K2)).treePrice();
+        auto V = crr::European<opt::PayoffButterfly>(S0, R, sigma, T, N, opt::PayoffButterfly(K1, K2), g_settings).treePrice();
         return toVariant(V);
     }
 )
@@ -441,7 +562,7 @@ SAFE_VARIANT(TreeButterfly,
 SAFE_VARIANT(TreeDeltaButterfly,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
     {
-        auto H = crr::European<opt::PayoffButterfly>(S0, R, sigma, T, N, opt::PayoffButterfly(K1, K2)).hedgingStrategy();
+        auto H = crr::European<opt::PayoffButterfly>(S0, R, sigma, T, N, opt::PayoffButterfly(K1, K2), g_settings).hedgingStrategy();
         return toVariant(H.delta);
     }
 )
@@ -449,7 +570,7 @@ SAFE_VARIANT(TreeDeltaButterfly,
 SAFE_VARIANT(TreeBondButterfly,
     (double S0, double R, double sigma, double T, int N, double K1, double K2),
     {
-        auto H = crr::European<opt::PayoffButterfly>(S0, R, sigma, T, N, opt::PayoffButterfly(K1, K2)).hedgingStrategy();
+        auto H = crr::European<opt::PayoffButterfly>(S0, R, sigma, T, N, opt::PayoffButterfly(K1, K2), g_settings).hedgingStrategy();
         return toVariant(H.bond);
     }
 )
@@ -462,18 +583,18 @@ using AsianCallArithmetic = crr::Asian<opt::PayoffCall, crr::Arithmetic>;  // la
 
 SAFE_DOUBLE(PriceAritCall,  
     (double S0, double R, double sigma, double T, int N, double K),  
-    return AsianCallArithmetic(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Arithmetic()).price();  
+    return AsianCallArithmetic(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Arithmetic(), g_settings).price();  
 )
 
 SAFE_DOUBLE(DeltaAritCall,
     (double S0, double R, double sigma, double T, int N, double K),
-    return AsianCallArithmetic(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Arithmetic()).deltaZero(); 
+    return AsianCallArithmetic(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Arithmetic(), g_settings).deltaZero(); 
 )
 
 SAFE_VARIANT(TreeAritCall,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto V = AsianCallArithmetic(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Arithmetic()).treePrice();
+        auto V = AsianCallArithmetic(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Arithmetic(), g_settings).treePrice();
         return toVariant(V);
     }
 )
@@ -481,7 +602,7 @@ SAFE_VARIANT(TreeAritCall,
 SAFE_VARIANT(TreeDeltaAritCall,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto H = AsianCallArithmetic(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Arithmetic()).hedgingStrategy();
+        auto H = AsianCallArithmetic(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Arithmetic(), g_settings).hedgingStrategy();
         return toVariant(H.delta);
     }
 )
@@ -489,19 +610,24 @@ SAFE_VARIANT(TreeDeltaAritCall,
 SAFE_VARIANT(TreeBondAritCall,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto H = AsianCallArithmetic(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Arithmetic()).hedgingStrategy();
+        auto H = AsianCallArithmetic(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Arithmetic(), g_settings).hedgingStrategy();
         return toVariant(H.bond);
     }
 )
 
 SAFE_DOUBLE(PriceAritCallMC,
     (double S0, double R, double sigma, double T, int N, double K),
-    return AsianCallArithmetic(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Arithmetic()).priceMC();
+    return AsianCallArithmetic(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Arithmetic(), g_settings).priceMC();
 )
 
 SAFE_DOUBLE(DeltaAritCallMC,
     (double S0, double R, double sigma, double T, int N, double K),
-    return AsianCallArithmetic(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Arithmetic()).deltaMC();
+    return AsianCallArithmetic(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Arithmetic(), g_settings).deltaMC();
+)
+
+SAFE_DOUBLE(ErrorAritCallMC,
+    (double S0, double R, double sigma, double T, int N, double K),
+    return AsianCallArithmetic(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Arithmetic(), g_settings).estimateMC().error;
 )
 
 //=============================================================================
@@ -512,18 +638,18 @@ using AsianPutArithmetic = crr::Asian<opt::PayoffPut, crr::Arithmetic>;
 
 SAFE_DOUBLE(PriceAritPut,
     (double S0, double R, double sigma, double T, int N, double K),
-    return AsianPutArithmetic(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Arithmetic()).price();
+    return AsianPutArithmetic(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Arithmetic(), g_settings).price();
 )
 
 SAFE_DOUBLE(DeltaAritPut,
     (double S0, double R, double sigma, double T, int N, double K),
-    return AsianPutArithmetic(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Arithmetic()).deltaZero();
+    return AsianPutArithmetic(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Arithmetic(), g_settings).deltaZero();
 )
 
 SAFE_VARIANT(TreeAritPut,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto V = AsianPutArithmetic(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Arithmetic()).treePrice();
+        auto V = AsianPutArithmetic(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Arithmetic(), g_settings).treePrice();
         return toVariant(V);
     }
 )
@@ -531,7 +657,7 @@ SAFE_VARIANT(TreeAritPut,
 SAFE_VARIANT(TreeDeltaAritPut,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto H = AsianPutArithmetic(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Arithmetic()).hedgingStrategy();
+        auto H = AsianPutArithmetic(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Arithmetic(), g_settings).hedgingStrategy();
         return toVariant(H.delta);
     }
 )
@@ -539,19 +665,24 @@ SAFE_VARIANT(TreeDeltaAritPut,
 SAFE_VARIANT(TreeBondAritPut,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto H = AsianPutArithmetic(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Arithmetic()).hedgingStrategy();
+        auto H = AsianPutArithmetic(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Arithmetic(), g_settings).hedgingStrategy();
         return toVariant(H.bond);
     }
 )
 
 SAFE_DOUBLE(PriceAritPutMC,
     (double S0, double R, double sigma, double T, int N, double K),
-    return AsianPutArithmetic(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Arithmetic()).priceMC();
+    return AsianPutArithmetic(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Arithmetic(), g_settings).priceMC();
 )
 
 SAFE_DOUBLE(DeltaAritPutMC,
     (double S0, double R, double sigma, double T, int N, double K),
-    return AsianPutArithmetic(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Arithmetic()).deltaMC();
+    return AsianPutArithmetic(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Arithmetic(), g_settings).deltaMC();
+)
+
+SAFE_DOUBLE(ErrorAritPutMC,
+    (double S0, double R, double sigma, double T, int N, double K),
+    return AsianPutArithmetic(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Arithmetic(), g_settings).estimateMC().error;
 )
 
 //=============================================================================
@@ -562,18 +693,18 @@ using AsianCallGeometric = crr::Asian<opt::PayoffCall, crr::Geometric>;
 
 SAFE_DOUBLE(PriceGeomCall,
     (double S0, double R, double sigma, double T, int N, double K),
-    return AsianCallGeometric(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Geometric()).price();
+    return AsianCallGeometric(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Geometric(), g_settings).price();
 )
 
 SAFE_DOUBLE(DeltaGeomCall,
     (double S0, double R, double sigma, double T, int N, double K),
-    return AsianCallGeometric(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Geometric()).deltaZero();
+    return AsianCallGeometric(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Geometric(), g_settings).deltaZero();
 )
 
 SAFE_VARIANT(TreeGeomCall,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto V = AsianCallGeometric(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Geometric()).treePrice();
+        auto V = AsianCallGeometric(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Geometric(), g_settings).treePrice();
         return toVariant(V);
     }
 )
@@ -581,7 +712,7 @@ SAFE_VARIANT(TreeGeomCall,
 SAFE_VARIANT(TreeDeltaGeomCall,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto H = AsianCallGeometric(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Geometric()).hedgingStrategy();
+        auto H = AsianCallGeometric(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Geometric(), g_settings).hedgingStrategy();
         return toVariant(H.delta);
     }
 )
@@ -589,19 +720,24 @@ SAFE_VARIANT(TreeDeltaGeomCall,
 SAFE_VARIANT(TreeBondGeomCall,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto H = AsianCallGeometric(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Geometric()).hedgingStrategy();
+        auto H = AsianCallGeometric(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Geometric(), g_settings).hedgingStrategy();
         return toVariant(H.bond);
     }
 )
 
 SAFE_DOUBLE(PriceGeomCallMC,
     (double S0, double R, double sigma, double T, int N, double K),
-    return AsianCallGeometric(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Geometric()).priceMC();
+    return AsianCallGeometric(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Geometric(), g_settings).priceMC();
 )
 
 SAFE_DOUBLE(DeltaGeomCallMC,
     (double S0, double R, double sigma, double T, int N, double K),
-    return AsianCallGeometric(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Geometric()).deltaMC();
+    return AsianCallGeometric(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Geometric(), g_settings).deltaMC();
+)
+
+SAFE_DOUBLE(ErrorGeomCallMC,
+    (double S0, double R, double sigma, double T, int N, double K),
+    return AsianCallGeometric(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Geometric(), g_settings).estimateMC().error;
 )
 
 //=============================================================================
@@ -612,18 +748,18 @@ using AsianPutGeometric = crr::Asian<opt::PayoffPut, crr::Geometric>;
 
 SAFE_DOUBLE(PriceGeomPut,
     (double S0, double R, double sigma, double T, int N, double K),
-    return AsianPutGeometric(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Geometric()).price();
+    return AsianPutGeometric(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Geometric(), g_settings).price();
 )
 
 SAFE_DOUBLE(DeltaGeomPut,
     (double S0, double R, double sigma, double T, int N, double K),
-    return AsianPutGeometric(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Geometric()).deltaZero();
+    return AsianPutGeometric(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Geometric(), g_settings).deltaZero();
 )
 
 SAFE_VARIANT(TreeGeomPut,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto V = AsianPutGeometric(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Geometric()).treePrice();
+        auto V = AsianPutGeometric(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Geometric(), g_settings).treePrice();
         return toVariant(V);
     }
 )
@@ -631,7 +767,7 @@ SAFE_VARIANT(TreeGeomPut,
 SAFE_VARIANT(TreeDeltaGeomPut,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto H = AsianPutGeometric(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Geometric()).hedgingStrategy();
+        auto H = AsianPutGeometric(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Geometric(), g_settings).hedgingStrategy();
         return toVariant(H.delta);
     }
 )
@@ -639,19 +775,24 @@ SAFE_VARIANT(TreeDeltaGeomPut,
 SAFE_VARIANT(TreeBondGeomPut,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto H = AsianPutGeometric(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Geometric()).hedgingStrategy();
+        auto H = AsianPutGeometric(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Geometric(), g_settings).hedgingStrategy();
         return toVariant(H.bond);
     }
 )
 
 SAFE_DOUBLE(PriceGeomPutMC,
     (double S0, double R, double sigma, double T, int N, double K),
-    return AsianPutGeometric(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Geometric()).priceMC();
+    return AsianPutGeometric(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Geometric(), g_settings).priceMC();
 )
 
 SAFE_DOUBLE(DeltaGeomPutMC,
     (double S0, double R, double sigma, double T, int N, double K),
-    return AsianPutGeometric(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Geometric()).deltaMC();
+    return AsianPutGeometric(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Geometric(), g_settings).deltaMC();
+)
+
+SAFE_DOUBLE(ErrorGeomPutMC,
+    (double S0, double R, double sigma, double T, int N, double K),
+    return AsianPutGeometric(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Geometric(), g_settings).estimateMC().error;
 )
 
 //=============================================================================
@@ -662,18 +803,18 @@ using AsianCallLookMax = crr::Asian<opt::PayoffCall, crr::LookMax>;
 
 SAFE_DOUBLE(PriceMaxCall,
     (double S0, double R, double sigma, double T, int N, double K),
-    return AsianCallLookMax(S0, R, sigma, T, N, opt::PayoffCall(K), crr::LookMax()).price();
+    return AsianCallLookMax(S0, R, sigma, T, N, opt::PayoffCall(K), crr::LookMax(), g_settings).price();
 )
 
 SAFE_DOUBLE(DeltaMaxCall,
     (double S0, double R, double sigma, double T, int N, double K),
-    return AsianCallLookMax(S0, R, sigma, T, N, opt::PayoffCall(K), crr::LookMax()).deltaZero();
+    return AsianCallLookMax(S0, R, sigma, T, N, opt::PayoffCall(K), crr::LookMax(), g_settings).deltaZero();
 )
 
 SAFE_VARIANT(TreeMaxCall,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto V = AsianCallLookMax(S0, R, sigma, T, N, opt::PayoffCall(K), crr::LookMax()).treePrice();
+        auto V = AsianCallLookMax(S0, R, sigma, T, N, opt::PayoffCall(K), crr::LookMax(), g_settings).treePrice();
         return toVariant(V);
     }
 )
@@ -681,7 +822,7 @@ SAFE_VARIANT(TreeMaxCall,
 SAFE_VARIANT(TreeDeltaMaxCall,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto H = AsianCallLookMax(S0, R, sigma, T, N, opt::PayoffCall(K), crr::LookMax()).hedgingStrategy();
+        auto H = AsianCallLookMax(S0, R, sigma, T, N, opt::PayoffCall(K), crr::LookMax(), g_settings).hedgingStrategy();
         return toVariant(H.delta);
     }
 )
@@ -689,19 +830,24 @@ SAFE_VARIANT(TreeDeltaMaxCall,
 SAFE_VARIANT(TreeBondMaxCall,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto H = AsianCallLookMax(S0, R, sigma, T, N, opt::PayoffCall(K), crr::LookMax()).hedgingStrategy();
+        auto H = AsianCallLookMax(S0, R, sigma, T, N, opt::PayoffCall(K), crr::LookMax(), g_settings).hedgingStrategy();
         return toVariant(H.bond);
     }
 )
 
 SAFE_DOUBLE(PriceMaxCallMC,
     (double S0, double R, double sigma, double T, int N, double K),
-    return AsianCallLookMax(S0, R, sigma, T, N, opt::PayoffCall(K), crr::LookMax()).priceMC();
+    return AsianCallLookMax(S0, R, sigma, T, N, opt::PayoffCall(K), crr::LookMax(), g_settings).priceMC();
 )
 
 SAFE_DOUBLE(DeltaMaxCallMC,
     (double S0, double R, double sigma, double T, int N, double K),
-    return AsianCallLookMax(S0, R, sigma, T, N, opt::PayoffCall(K), crr::LookMax()).deltaMC();
+    return AsianCallLookMax(S0, R, sigma, T, N, opt::PayoffCall(K), crr::LookMax(), g_settings).deltaMC();
+)
+
+SAFE_DOUBLE(ErrorMaxCallMC,
+    (double S0, double R, double sigma, double T, int N, double K),
+    return AsianCallLookMax(S0, R, sigma, T, N, opt::PayoffCall(K), crr::LookMax(), g_settings).estimateMC().error;
 )
 
 //=============================================================================
@@ -712,18 +858,18 @@ using AsianPutLookMin = crr::Asian<opt::PayoffPut, crr::LookMin>;
 
 SAFE_DOUBLE(PriceMinPut,
     (double S0, double R, double sigma, double T, int N, double K),
-    return AsianPutLookMin(S0, R, sigma, T, N, opt::PayoffPut(K), crr::LookMin()).price();
+    return AsianPutLookMin(S0, R, sigma, T, N, opt::PayoffPut(K), crr::LookMin(), g_settings).price();
 )
 
 SAFE_DOUBLE(DeltaMinPut,
     (double S0, double R, double sigma, double T, int N, double K),
-    return AsianPutLookMin(S0, R, sigma, T, N, opt::PayoffPut(K), crr::LookMin()).deltaZero();
+    return AsianPutLookMin(S0, R, sigma, T, N, opt::PayoffPut(K), crr::LookMin(), g_settings).deltaZero();
 )
 
 SAFE_VARIANT(TreeMinPut,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto V = AsianPutLookMin(S0, R, sigma, T, N, opt::PayoffPut(K), crr::LookMin()).treePrice();
+        auto V = AsianPutLookMin(S0, R, sigma, T, N, opt::PayoffPut(K), crr::LookMin(), g_settings).treePrice();
         return toVariant(V);
     }
 )
@@ -731,7 +877,7 @@ SAFE_VARIANT(TreeMinPut,
 SAFE_VARIANT(TreeDeltaMinPut,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto H = AsianPutLookMin(S0, R, sigma, T, N, opt::PayoffPut(K), crr::LookMin()).hedgingStrategy();
+        auto H = AsianPutLookMin(S0, R, sigma, T, N, opt::PayoffPut(K), crr::LookMin(), g_settings).hedgingStrategy();
         return toVariant(H.delta);
     }
 )
@@ -739,19 +885,99 @@ SAFE_VARIANT(TreeDeltaMinPut,
 SAFE_VARIANT(TreeBondMinPut,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto H = AsianPutLookMin(S0, R, sigma, T, N, opt::PayoffPut(K), crr::LookMin()).hedgingStrategy();
+        auto H = AsianPutLookMin(S0, R, sigma, T, N, opt::PayoffPut(K), crr::LookMin(), g_settings).hedgingStrategy();
         return toVariant(H.bond);
     }
 )
 
 SAFE_DOUBLE(PriceMinPutMC,
     (double S0, double R, double sigma, double T, int N, double K),
-    return AsianPutLookMin(S0, R, sigma, T, N, opt::PayoffPut(K), crr::LookMin()).priceMC();
+    return AsianPutLookMin(S0, R, sigma, T, N, opt::PayoffPut(K), crr::LookMin(), g_settings).priceMC();
 )
 
 SAFE_DOUBLE(DeltaMinPutMC,
     (double S0, double R, double sigma, double T, int N, double K),
-    return AsianPutLookMin(S0, R, sigma, T, N, opt::PayoffPut(K), crr::LookMin()).deltaMC();
+    return AsianPutLookMin(S0, R, sigma, T, N, opt::PayoffPut(K), crr::LookMin(), g_settings).deltaMC();
+)
+
+SAFE_DOUBLE(ErrorMinPutMC,
+    (double S0, double R, double sigma, double T, int N, double K),
+    return AsianPutLookMin(S0, R, sigma, T, N, opt::PayoffPut(K), crr::LookMin(), g_settings).estimateMC().error;
+)
+
+//=============================================================================
+// Asiatiques Hull-White
+//=============================================================================
+
+using AsianHWCallArithmetic = crr::AsianHullWhite<opt::PayoffCall, crr::Arithmetic>;
+using AsianHWPutArithmetic = crr::AsianHullWhite<opt::PayoffPut, crr::Arithmetic>;
+using AsianHWCallGeometric = crr::AsianHullWhite<opt::PayoffCall, crr::Geometric>;
+using AsianHWPutGeometric = crr::AsianHullWhite<opt::PayoffPut, crr::Geometric>;
+
+SAFE_DOUBLE(PriceAritCallHW,
+    (double S0, double R, double sigma, double T, int N, double K, int M),
+    return AsianHWCallArithmetic(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Arithmetic(), M, g_settings).price();
+)
+
+SAFE_DOUBLE(DeltaAritCallHW,
+    (double S0, double R, double sigma, double T, int N, double K, int M),
+    return AsianHWCallArithmetic(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Arithmetic(), M, g_settings).deltaZero();
+)
+
+SAFE_DOUBLE(PriceAritPutHW,
+    (double S0, double R, double sigma, double T, int N, double K, int M),
+    return AsianHWPutArithmetic(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Arithmetic(), M, g_settings).price();
+)
+
+SAFE_DOUBLE(DeltaAritPutHW,
+    (double S0, double R, double sigma, double T, int N, double K, int M),
+    return AsianHWPutArithmetic(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Arithmetic(), M, g_settings).deltaZero();
+)
+
+SAFE_DOUBLE(PriceGeomCallHW,
+    (double S0, double R, double sigma, double T, int N, double K, int M),
+    return AsianHWCallGeometric(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Geometric(), M, g_settings).price();
+)
+
+SAFE_DOUBLE(DeltaGeomCallHW,
+    (double S0, double R, double sigma, double T, int N, double K, int M),
+    return AsianHWCallGeometric(S0, R, sigma, T, N, opt::PayoffCall(K), crr::Geometric(), M, g_settings).deltaZero();
+)
+
+SAFE_DOUBLE(PriceGeomPutHW,
+    (double S0, double R, double sigma, double T, int N, double K, int M),
+    return AsianHWPutGeometric(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Geometric(), M, g_settings).price();
+)
+
+SAFE_DOUBLE(DeltaGeomPutHW,
+    (double S0, double R, double sigma, double T, int N, double K, int M),
+    return AsianHWPutGeometric(S0, R, sigma, T, N, opt::PayoffPut(K), crr::Geometric(), M, g_settings).deltaZero();
+)
+
+//=============================================================================
+// Livre d'asiatiques
+//=============================================================================
+
+/**
+ * @brief Les huit asiatiques de strike K : (Arit, Geom, Max, Min) x (Call, Put).
+ */
+static std::vector<crr::AsianBook::Product> asianBookProducts(double K) {
+    std::shared_ptr<const crr::Aggregator> aggregators[4] = { std::make_shared<crr::Arithmetic>(),
+        std::make_shared<crr::Geometric>(), std::make_shared<crr::LookMax>(), std::make_shared<crr::LookMin>() };
+    std::vector<crr::AsianBook::Product> products;
+    for (const auto& a : aggregators) {
+        products.push_back({ std::make_shared<opt::PayoffCall>(K), a });
+        products.push_back({ std::make_shared<opt::PayoffPut>(K), a });
+    }
+    return products;
+}
+
+SAFE_VARIANT(PriceAsianBook,
+    (double S0, double R, double sigma, double T, int N, double K),
+    {
+        std::vector<std::vector<double>> column(1, crr::AsianBook(S0, R, sigma, T, N, asianBookProducts(K), g_settings).prices());
+        return toVariant(column);
+    }
 )
 
 //=============================================================================
@@ -760,18 +986,18 @@ SAFE_DOUBLE(DeltaMinPutMC,
 
 SAFE_DOUBLE(PriceAmCall,
     (double S0, double R, double sigma, double T, int N, double K),
-    return crr::American<opt::PayoffCall>(S0, R, sigma, T, N, opt::PayoffCall(K)).price();
+    return crr::American<opt::PayoffCall>(S0, R, sigma, T, N, opt::PayoffCall(K), g_settings).price();
 )
 
 SAFE_DOUBLE(DeltaAmCall,
     (double S0, double R, double sigma, double T, int N, double K),
-    return crr::American<opt::PayoffCall>(S0, R, sigma, T, N, opt::PayoffCall(K)).deltaZero();
+    return crr::American<opt::PayoffCall>(S0, R, sigma, T, N, opt::PayoffCall(K), g_settings).deltaZero();
 )
 
 SAFE_VARIANT(TreeAmCall,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto V = crr::American<opt::PayoffCall>(S0, R, sigma, T, N, opt::PayoffCall(K)).treePrice();
+        auto V = crr::American<opt::PayoffCall>(S0, R, sigma, T, N, opt::PayoffCall(K), g_settings).treePrice();
         return toVariant(V);
     }
 )
@@ -779,7 +1005,7 @@ SAFE_VARIANT(TreeAmCall,
 SAFE_VARIANT(TreeDeltaAmCall,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto H = crr::American<opt::PayoffCall>(S0, R, sigma, T, N, opt::PayoffCall(K)).hedgingStrategy();
+        auto H = crr::American<opt::PayoffCall>(S0, R, sigma, T, N, opt::PayoffCall(K), g_settings).hedgingStrategyNR();
         return toVariant(H.delta);
     }
 )
@@ -787,7 +1013,7 @@ SAFE_VARIANT(TreeDeltaAmCall,
 SAFE_VARIANT(TreeBondAmCall,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto H = crr::American<opt::PayoffCall>(S0, R, sigma, T, N, opt::PayoffCall(K)).hedgingStrategy();
+        auto H = crr::American<opt::PayoffCall>(S0, R, sigma, T, N, opt::PayoffCall(K), g_settings).hedgingStrategyNR();
         return toVariant(H.bond);
     }
 )
@@ -798,18 +1024,18 @@ SAFE_VARIANT(TreeBondAmCall,
 
 SAFE_DOUBLE(PriceAmPut,
     (double S0, double R, double sigma, double T, int N, double K),
-    return crr::American<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K)).price();
+    return crr::American<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K), g_settings).price();
 )
 
 SAFE_DOUBLE(DeltaAmPut,
     (double S0, double R, double sigma, double T, int N, double K),
-    return crr::American<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K)).deltaZero();
+    return crr::American<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K), g_settings).deltaZero();
 )
 
 SAFE_VARIANT(TreeAmPut,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto V = crr::American<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K)).treePrice();
+        auto V = crr::American<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K), g_settings).treePrice();
         return toVariant(V);
     }
 )
@@ -817,7 +1043,7 @@ SAFE_VARIANT(TreeAmPut,
 SAFE_VARIANT(TreeDeltaAmPut,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto H = crr::American<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K)).hedgingStrategy();
+        auto H = crr::American<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K), g_settings).hedgingStrategyNR();
         return toVariant(H.delta);
     }
 )
@@ -825,19 +1051,27 @@ SAFE_VARIANT(TreeDeltaAmPut,
 SAFE_VARIANT(TreeBondAmPut,
     (double S0, double R, double sigma, double T, int N, double K),
     {
-        auto H = crr::American<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K)).hedgingStrategy();
+        auto H = crr::American<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K), g_settings).hedgingStrategyNR();
         return toVariant(H.bond);
     }
 )
 
+SAFE_VARIANT(BoundaryAmPut,
+    (double S0, double R, double sigma, double T, int N, double K),
+    {
+        auto B = crr::American<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K), g_settings).exerciseBoundary();
+        return toVariantNA({ B.time, B.stock });
+    }
+)
+
 SAFE_DOUBLE(PriceAmPutRR,
     (double S0, double R, double sigma, double T, int N, double K),
-    return crr::American<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K)).priceRR();
+    return crr::American<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K), g_settings).priceRR();
 )
 
 SAFE_DOUBLE(DeltaAmPutRR,
     (double S0, double R, double sigma, double T, int N, double K),
-    return crr::American<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K)).deltaRR();
+    return crr::American<opt::PayoffPut>(S0, R, sigma, T, N, opt::PayoffPut(K), g_settings).deltaRR();
 )
 
 //=============================================================================
@@ -6,6 +6,8 @@
 #include "European.h"
 #include "Aggregator.h"
 #include "Asian.h"
+#include "AsianHullWhite.h"
+#include "AsianBook.h"
 #include "American.h"
 #include "ParabPDE.h"
 #include "Volatility.h"
@@ -19,6 +21,57 @@
 
 extern "C" {
 
+    //=============================================================================
+    // Paramètres
+    //=============================================================================
+
+    /**
+     * @brief Choisit la paramétrisation des arbres binomiaux pour tous les exports suivants.
+     * @param kind 0 : classique, 1 : Cox-Ross-Rubinstein, 2 : Jarrow-Rudd, 3 : Tian, 4 : Leisen-Reimer.
+     * @details Avec Leisen-Reimer, un N pair passé aux exports est arrondi à N + 1.
+     * @return La paramétrisation retenue.
+     */
+    __declspec(dllexport) double __stdcall SetParameterization(int kind);
+
+    /**
+     * @brief Choisit le lissage du dernier pas des arbres européens et américains (Price*, Delta*).
+     * @param mode 0 : aucun, 1 : BBS, 2 : BBSR.
+     * @details Avec Leisen-Reimer (SetParameterization(4)), le dernier pas n’est pas lissé : BBS est
+     *          sans effet et BBSR extrapole les arbres américains non lissés.
+     * @return Le lissage retenu.
+     */
+    __declspec(dllexport) double __stdcall SetSmoothing(int mode);
+
+    /**
+     * @brief Choisit le nombre de threads des moteurs parallèles (arbres et Monte Carlo).
+     * @param threads 1 : séquentiel, 0 : tous les cœurs ; borné à 4 threads par cœur.
+     * @return Le nombre de threads effectif.
+     */
+    __declspec(dllexport) double __stdcall SetThreads(int threads);
+
+    /**
+     * @brief Choisit les paramètres des exports Monte Carlo (Price*MC, Delta*MC).
+     * @param steps Pas de temps par trajectoire.
+     * @param paths Nombre de trajectoires.
+     * @param seed  Graine : mêmes tirages pour une même graine, quel que soit le nombre de threads.
+     * @return Le nombre de trajectoires retenu : paths, ou en mode Sobol (SetSampling) paths
+     *         arrondi par défaut à replicates 2^m.
+     */
+    __declspec(dllexport) double __stdcall SetMonteCarlo(int steps, int paths, int seed);
+
+    /**
+     * @brief Choisit les tirages des exports Monte Carlo (Price*MC, Delta*MC, Error*MC).
+     * @param mode       0 : pseudo-aléatoires, 1 : Sobol brouillé et pont brownien (quasi-Monte Carlo).
+     * @param replicates Répétitions brouillées indépendantes du mode Sobol, qui se partagent les
+     *                   trajectoires et donnent l'erreur type.
+     * @details En mode Sobol, chaque répétition compte 2^m points, la plus grande puissance de deux
+     *          n'excédant pas trajectoires / replicates : le nombre de trajectoires de SetMonteCarlo
+     *          est arrondi par défaut à replicates 2^m (10000 trajectoires et 16 répétitions : 8192).
+     *          Le mode Sobol accepte au plus 481 pas par trajectoire (une dimension par pas).
+     * @return Le mode retenu.
+     */
+    __declspec(dllexport) double __stdcall SetSampling(int mode, int replicates);
+
     //=============================================================================
     // Vanilla Call
     //=============================================================================
@@ -423,6 +476,13 @@ extern "C" {
         double S0, double R, double sigma, double T, int N, double K
     );
 
+    /**
+     * @brief Calcule l'erreur type du prix MC d'un call sur moyenne arithmétique.
+     */
+    __declspec(dllexport) double __stdcall ErrorAritCallMC(
+        double S0, double R, double sigma, double T, int N, double K
+    );
+
     //=============================================================================
     // Arithmetic Put
     //=============================================================================
@@ -476,6 +536,13 @@ extern "C" {
         double S0, double R, double sigma, double T, int N, double K
     );
 
+    /**
+     * @brief Calcule l'erreur type du prix MC d'un put sur moyenne arithmétique.
+     */
+    __declspec(dllexport) double __stdcall ErrorAritPutMC(
+        double S0, double R, double sigma, double T, int N, double K
+    );
+
     //=============================================================================
     // Geometric Call
     //=============================================================================
@@ -529,6 +596,13 @@ extern "C" {
         double S0, double R, double sigma, double T, int N, double K
     );
 
+    /**
+     * @brief Calcule l'erreur type du prix MC d'un call sur moyenne géométrique.
+     */
+    __declspec(dllexport) double __stdcall ErrorGeomCallMC(
+        double S0, double R, double sigma, double T, int N, double K
+    );
+
     //=============================================================================
     // Geometric Put
     //=============================================================================
@@ -582,6 +656,13 @@ extern "C" {
         double S0, double R, double sigma, double T, int N, double K
     );
 
+    /**
+     * @brief Calcule l'erreur type du prix MC d'un put sur moyenne géométrique.
+     */
+    __declspec(dllexport) double __stdcall ErrorGeomPutMC(
+        double S0, double R, double sigma, double T, int N, double K
+    );
+
     //=============================================================================
     // Lookback Call
     //=============================================================================
@@ -635,6 +716,13 @@ extern "C" {
         double S0, double R, double sigma, double T, int N, double K
     );
 
+    /**
+     * @brief Calcule l'erreur type du prix MC d'un call sur max.
+     */
+    __declspec(dllexport) double __stdcall ErrorMaxCallMC(
+        double S0, double R, double sigma, double T, int N, double K
+    );
+
     //=============================================================================
     // Lookback Put
     //=============================================================================
@@ -688,6 +776,85 @@ extern "C" {
         double S0, double R, double sigma, double T, int N, double K
     );
 
+    /**
+     * @brief Calcule l'erreur type du prix MC d'un put sur min.
+     */
+    __declspec(dllexport) double __stdcall ErrorMinPutMC(
+        double S0, double R, double sigma, double T, int N, double K
+    );
+
+    //=============================================================================
+    // Asiatiques Hull-White
+    //=============================================================================
+
+    /**
+     * @brief Calcule le prix Hull-White d'un call sur moyenne arithmétique (M moyennes par nœud).
+     */
+    __declspec(dllexport) double __stdcall PriceAritCallHW(
+        double S0, double R, double sigma, double T, int N, double K, int M
+    );
+
+    /**
+     * @brief Calcule le delta Hull-White d'un call sur moyenne arithmétique (M moyennes par nœud).
+     */
+    __declspec(dllexport) double __stdcall DeltaAritCallHW(
+        double S0, double R, double sigma, double T, int N, double K, int M
+    );
+
+    /**
+     * @brief Calcule le prix Hull-White d'un put sur moyenne arithmétique (M moyennes par nœud).
+     */
+    __declspec(dllexport) double __stdcall PriceAritPutHW(
+        double S0, double R, double sigma, double T, int N, double K, int M
+    );
+
+    /**
+     * @brief Calcule le delta Hull-White d'un put sur moyenne arithmétique (M moyennes par nœud).
+     */
+    __declspec(dllexport) double __stdcall DeltaAritPutHW(
+        double S0, double R, double sigma, double T, int N, double K, int M
+    );
+
+    /**
+     * @brief Calcule le prix Hull-White d'un call sur moyenne géométrique (M moyennes par nœud).
+     */
+    __declspec(dllexport) double __stdcall PriceGeomCallHW(
+        double S0, double R, double sigma, double T, int N, double K, int M
+    );
+
+    /**
+     * @brief Calcule le delta Hull-White d'un call sur moyenne géométrique (M moyennes par nœud).
+     */
+    __declspec(dllexport) double __stdcall DeltaGeomCallHW(
+        double S0, double R, double sigma, double T, int N, double K, int M
+    );
+
+    /**
+     * @brief Calcule le prix Hull-White d'un put sur moyenne géométrique (M moyennes par nœud).
+     */
+    __declspec(dllexport) double __stdcall PriceGeomPutHW(
+        double S0, double R, double sigma, double T, int N, double K, int M
+    );
+
+    /**
+     * @brief Calcule le delta Hull-White d'un put sur moyenne géométrique (M moyennes par nœud).
+     */
+    __declspec(dllexport) double __stdcall DeltaGeomPutHW(
+        double S0, double R, double sigma, double T, int N, double K, int M
+    );
+
+    //=============================================================================
+    // Livre d'asiatiques
+    //=============================================================================
+
+    /**
+     * @brief Prix des huit asiatiques de strike K (moyennes arithmétique et géométrique, maximum,
+     *        minimum ; call puis put) en un seul parcours de l'arbre, en colonne.
+     */
+    __declspec(dllexport) VARIANT __stdcall PriceAsianBook(
+        double S0, double R, double sigma, double T, int N, double K
+    );
+
     //=============================================================================
     // American Call
     //=============================================================================
@@ -767,14 +934,30 @@ extern "C" {
     );
 
     /**
-     * @brief Calcule le prix Repeated Richardson d'un put américain.
+     * @brief Renvoie la frontière d'exercice anticipé du put américain :
+     *        colonne 0 les dates t_n, colonne 1 le prix critique S*(t_n) (#N/A si aucun exercice).
+     * @details Avec un taux <= 0, le put n'est jamais exercé avant l'échéance : seule la dernière
+     *          ligne porte un prix critique.
+     */
+    __declspec(dllexport) VARIANT __stdcall BoundaryAmPut(
+        double S0, double R, double sigma, double T, int N, double K
+    );
+
+    /**
+     * @brief Calcule le prix Repeated Richardson d'un put américain (arbres N, 2N et 4N).
+     * @details L'échelle suit N : les versions précédentes utilisaient toujours 100, 200 et 400 pas
+     *          quel que soit N : le résultat n'est inchangé que pour N = 100. Les arbres de l'échelle
+     *          sont valorisés en parallèle selon SetThreads.
      */
     __declspec(dllexport) double __stdcall PriceAmPutRR(
         double S0, double R, double sigma, double T, int N, double K
     );
 
     /**
-     * @brief Calcule le delta Repeated Richardson d'un put américain.
+     * @brief Calcule le delta Repeated Richardson d'un put américain (arbres N, 2N et 4N).
+     * @details L'échelle suit N : les versions précédentes utilisaient toujours 100, 200 et 400 pas
+     *          quel que soit N : le résultat n'est inchangé que pour N = 100. Les arbres de l'échelle
+     *          sont valorisés en parallèle selon SetThreads.
      */
     __declspec(dllexport) double __stdcall DeltaAmPutRR(
         double S0, double R, double sigma, double T, int N, double K
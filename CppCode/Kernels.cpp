@@ -0,0 +1,1324 @@
+#include "pch.h"
+#include "Kernels.h"
+#include "MonteCarlo.h"
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CRR_SIMD_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang n'émettent une instruction que si la fonction est compilée pour sa cible ;
+// MSVC accepte les intrinsèques partout, la sélection se fait uniquement à l'exécution.
+#if defined(__GNUC__) || defined(__clang__)
+#define CRR_TARGET(isa) __attribute__((target(isa)))
+#else
+#define CRR_TARGET(isa)
+#endif
+
+// Pas de contraction mul + add en FMA : tous les chemins doivent produire les mêmes bits.
+// MSVC ne contracte pas sous /fp:precise ; GCC le ferait dès que la cible dispose de FMA.
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace crr {
+namespace simd {
+
+    namespace {
+
+        //=====================================================================
+        // Chemin scalaire (référence et fin de boucle des chemins vectoriels)
+        //=====================================================================
+
+        void rollbackScalar(double* V, int n, double pu, double pd) {
+            for (int i = 0; i < n; ++i)
+                V[i] = pu * V[i + 1] + pd * V[i];
+        }
+
+        void rollbackMaxScalar(double* V, const double* E, int n, double pu, double pd) {
+            for (int i = 0; i < n; ++i)
+                V[i] = std::max<double>(E[i], pu * V[i + 1] + pd * V[i]);
+        }
+
+        void stepScalar(const double* next, double* cur, int n, double pu, double pd) {
+            for (int i = 0; i < n; ++i)
+                cur[i] = pu * next[i + 1] + pd * next[i];
+        }
+
+        void stepMaxScalar(const double* next, const double* E, double* cur, int n, double pu, double pd) {
+            for (int i = 0; i < n; ++i)
+                cur[i] = std::max<double>(E[i], pu * next[i + 1] + pd * next[i]);
+        }
+
+        void rollback3Scalar(double* V, int n, double pu, double pm, double pd) {
+            for (int i = 0; i < n; ++i)
+                V[i] = pu * V[i + 2] + pm * V[i + 1] + pd * V[i];
+        }
+
+        void rollbackMax3Scalar(double* V, const double* E, int n, double pu, double pm, double pd) {
+            for (int i = 0; i < n; ++i)
+                V[i] = std::max<double>(E[i], pu * V[i + 2] + pm * V[i + 1] + pd * V[i]);
+        }
+
+        void step3Scalar(const double* next, double* cur, int n, double pu, double pm, double pd) {
+            for (int i = 0; i < n; ++i)
+                cur[i] = pu * next[i + 2] + pm * next[i + 1] + pd * next[i];
+        }
+
+        void stepMax3Scalar(const double* next, const double* E, double* cur, int n, double pu, double pm, double pd) {
+            for (int i = 0; i < n; ++i)
+                cur[i] = std::max<double>(E[i], pu * next[i + 2] + pm * next[i + 1] + pd * next[i]);
+        }
+
+        void rollbackStridedScalar(double* V, int n, int stride, double pu, double pd) {
+            for (int j = 0; j < n; ++j)
+                V[j] = pu * V[j + stride] + pd * V[j];
+        }
+
+        void rollbackMaxStrikesScalar(double* V, const double* S, const double* K, int M, int n,
+            double pu, double pd, bool put)
+        {
+            for (int i = 0; i < n; ++i) {
+                double* row = V + std::size_t(i) * M;
+                for (int m = 0; m < M; ++m) {
+                    double e = put ? std::max<double>(K[m] - S[i], 0.0) : std::max<double>(S[i] - K[m], 0.0);
+                    row[m] = std::max<double>(e, pu * row[m + M] + pd * row[m]);
+                }
+            }
+        }
+
+        void callScalar(const double* S, double K, double* out, int n) {
+            for (int i = 0; i < n; ++i)
+                out[i] = std::max<double>(S[i] - K, 0.0);
+        }
+
+        void putScalar(const double* S, double K, double* out, int n) {
+            for (int i = 0; i < n; ++i)
+                out[i] = std::max<double>(K - S[i], 0.0);
+        }
+
+        /// Réduction commune : 8 sommes partielles combinées dans un ordre fixe
+        double reduce8(const double* s) {
+            return ((s[0] + s[1]) + (s[2] + s[3])) + ((s[4] + s[5]) + (s[6] + s[7]));
+        }
+
+        double dotTail(const double* a, const double* b, int i, int n, double* s) {
+            for (int j = 0; i + j < n; ++j)
+                s[j] += a[i + j] * b[i + j];
+            return reduce8(s);
+        }
+
+        double dotScalar(const double* a, const double* b, int n) {
+            double s[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+            int i = 0;
+            for (; i + 8 <= n; i += 8)
+                for (int j = 0; j < 8; ++j)
+                    s[j] += a[i + j] * b[i + j];
+            return dotTail(a, b, i, n, s);
+        }
+
+        //=====================================================================
+        // Fonctions élémentaires de Monte Carlo (référence scalaire)
+        //=====================================================================
+
+        // Les chemins vectoriels refont exactement les mêmes opérations, dans le même ordre.
+        const double roundMagic = 6755399441055744.0;     // 1.5 2^52 : (x + roundMagic) - roundMagic arrondit x
+        const double ln2Hi = 6.93147180369123816490e-01;  // 32 bits significatifs : k ln2Hi exact pour |k| < 2^21
+        const double ln2Lo = 1.90821492927058770002e-10;
+        const double log2e = 1.44269504088896338700e+00;
+        const double sqrt2 = 1.41421356237309514547e+00;
+        const double halfPi = 1.57079632679489655800e+00;
+        const double halfUlp = 1.1102230246251565404e-16;  // 2^-53
+        const std::uint64_t oneBits = 0x3FF0000000000000ull;
+
+        /// exp(r) = somme des r^k / k!, k = 0..13, pour |r| <= ln2 / 2
+        const double expCoef[14] = { 1.0 / 6227020800.0, 1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0,
+            1.0 / 362880.0, 1.0 / 40320.0, 1.0 / 5040.0, 1.0 / 720.0, 1.0 / 120.0, 1.0 / 24.0, 1.0 / 6.0, 0.5, 1.0, 1.0 };
+        /// log(m) = 2 atanh(s) = 2 (s + s^3 / 3 + ... + s^21 / 21), s = (m - 1) / (m + 1), |s| <= 0.172
+        const double logCoef[10] = { 1.0 / 21, 1.0 / 19, 1.0 / 17, 1.0 / 15, 1.0 / 13, 1.0 / 11, 1.0 / 9, 1.0 / 7,
+            1.0 / 5, 1.0 / 3 };
+        /// sin(t) = t + t^3 P(t^2), cos(t) = 1 + t^2 Q(t^2), |t| <= pi / 4
+        const double sinCoef[8] = { -1.0 / 355687428096000.0, 1.0 / 1307674368000.0, -1.0 / 6227020800.0,
+            1.0 / 39916800.0, -1.0 / 362880.0, 1.0 / 5040.0, -1.0 / 120.0, 1.0 / 6.0 };
+        const double cosCoef[9] = { 1.0 / 6402373705728000.0, -1.0 / 20922789888000.0, 1.0 / 87178291200.0,
+            -1.0 / 479001600.0, 1.0 / 3628800.0, -1.0 / 40320.0, 1.0 / 720.0, -1.0 / 24.0, 0.5 };
+        /// Acklam : Φ^-1(u) = r A(r^2) / B(r^2), r = u - 1/2, pour acklamLow <= u <= 1 - acklamLow,
+        /// et -C(t) / D(t), t = √(-2 log q), q = min(u, 1 - u), dans les queues (signe de u - 1/2)
+        const double acklamA[6] = { -3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+            1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00 };
+        const double acklamB[6] = { -5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+            6.680131188771972e+01, -1.328068155288572e+01, 1.0 };
+        const double acklamC[6] = { -7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+            -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00 };
+        const double acklamD[5] = { 7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+            3.754408661907416e+00, 1.0 };
+        const double acklamLow = 0.02425;
+
+        double fromBits(std::uint64_t b) {
+            double x;
+            std::memcpy(&x, &b, sizeof x);
+            return x;
+        }
+
+        std::uint64_t toBits(double x) {
+            std::uint64_t b;
+            std::memcpy(&b, &x, sizeof b);
+            return b;
+        }
+
+        /// Clés des dix tours de Philox4x32-10
+        void philoxKeys(std::uint64_t seed, std::uint32_t k0[10], std::uint32_t k1[10]) {
+            k0[0] = std::uint32_t(seed);
+            k1[0] = std::uint32_t(seed >> 32);
+            for (int r = 1; r < 10; ++r) {
+                k0[r] = k0[r - 1] + 0x9E3779B9u;
+                k1[r] = k1[r - 1] + 0xBB67AE85u;
+            }
+        }
+
+        /// Uniforme dans ]0, 1[ : 52 bits de poids fort de (hi, lo), centrée dans sa case
+        double uniformScalar(std::uint32_t hi, std::uint32_t lo) {
+            std::uint64_t x = (std::uint64_t(hi) << 32) | lo;
+            return (fromBits((x >> 12) | oneBits) - 1.0) + halfUlp;
+        }
+
+        double expScalar(double x) {
+            x = std::min<double>(std::max<double>(x, -708.0), 709.0);
+            double t = x * log2e + roundMagic;
+            double k = t - roundMagic;
+            double r = (x - k * ln2Hi) - k * ln2Lo;
+            double p = expCoef[0];
+            for (int c = 1; c < 14; ++c)
+                p = p * r + expCoef[c];
+            // Les bits de poids faible de t contiennent k : 2^k en construisant l'exposant
+            return p * fromBits((toBits(t) + 1023) << 52);
+        }
+
+        /// Logarithme d'un réel normal strictement positif
+        double logScalar(double x) {
+            std::uint64_t b = toBits(x);
+            double e = fromBits((b >> 52) | 0x4330000000000000ull) - 4503599627371519.0;  // 2^52 + 1023
+            double m = fromBits((b & 0x000FFFFFFFFFFFFFull) | oneBits);
+            if (m > sqrt2) {
+                m = m * 0.5;
+                e = e + 1.0;
+            }
+            double f = m - 1.0;
+            double s = f / (2.0 + f);
+            double s2 = s * s;
+            double p = logCoef[0];
+            for (int c = 1; c < 10; ++c)
+                p = p * s2 + logCoef[c];
+            double t = s + s;
+            return e * ln2Hi + (e * ln2Lo + (t + t * (s2 * p)));
+        }
+
+        /// cos(2 pi u) et sin(2 pi u) : réduction exacte au quart de tour le plus proche
+        void sinCosTurnsScalar(double u, double& c, double& s) {
+            double u4 = u * 4.0;
+            double q = (u4 + roundMagic) - roundMagic;
+            double t = (u4 - q) * halfPi;
+            double t2 = t * t;
+            double ps = sinCoef[0];
+            for (int k = 1; k < 8; ++k)
+                ps = ps * t2 + sinCoef[k];
+            double pc = cosCoef[0];
+            for (int k = 1; k < 9; ++k)
+                pc = pc * t2 + cosCoef[k];
+            double sn = t - t * (t2 * ps);
+            double cs = 1.0 - t2 * pc;
+            bool swap = q == 1.0 || q == 3.0;
+            double a = swap ? sn : cs, b = swap ? cs : sn;
+            c = (q == 1.0 || q == 2.0) ? -a : a;
+            s = (q == 2.0 || q == 3.0) ? -b : b;
+        }
+
+        void normalPairsScalar(std::uint64_t seed, std::uint64_t path0, std::uint32_t pair, double* z0, double* z1, int n) {
+            std::uint32_t key[2] = { std::uint32_t(seed), std::uint32_t(seed >> 32) };
+            for (int i = 0; i < n; ++i) {
+                std::uint64_t path = path0 + i;
+                std::uint32_t counter[4] = { pair, std::uint32_t(path), std::uint32_t(path >> 32), 0u };
+                std::uint32_t r[4];
+                philox4x32(counter, key, r);
+                double radius = std::sqrt(-2.0 * logScalar(uniformScalar(r[0], r[1])));
+                double c, s;
+                sinCosTurnsScalar(uniformScalar(r[2], r[3]), c, s);
+                z0[i] = radius * c;
+                z1[i] = radius * s;
+            }
+        }
+
+        void gbmStepScalar(const double* S, const double* Z, double* next, int n, double drift, double vol) {
+            for (int i = 0; i < n; ++i)
+                next[i] = S[i] * expScalar(drift + vol * Z[i]);
+        }
+
+        // Queue de Φ^-1 en q = min(u, 1 - u) < acklamLow (1 - u est exact pour u >= 1/2)
+        double tailInverseScalar(double q) {
+            double t = std::sqrt(-2.0 * logScalar(q));
+            double pc = acklamC[0], pd = acklamD[0];
+            for (int k = 1; k < 6; ++k)
+                pc = pc * t + acklamC[k];
+            for (int k = 1; k < 5; ++k)
+                pd = pd * t + acklamD[k];
+            return pc / pd;
+        }
+
+        void inverseNormalScalar(const double* u, double* z, int n) {
+            for (int i = 0; i < n; ++i) {
+                double x = u[i];
+                if (x < acklamLow || x > 1.0 - acklamLow) {
+                    double tail = tailInverseScalar(std::min(x, 1.0 - x));
+                    z[i] = x > 0.5 ? -tail : tail;
+                    continue;
+                }
+                double r = x - 0.5, r2 = r * r;
+                double pa = acklamA[0], pb = acklamB[0];
+                for (int k = 1; k < 6; ++k) {
+                    pa = pa * r2 + acklamA[k];
+                    pb = pb * r2 + acklamB[k];
+                }
+                z[i] = pa * r / pb;
+            }
+        }
+
+#ifdef CRR_SIMD_X86
+
+        //=====================================================================
+        // SSE2
+        //=====================================================================
+
+        CRR_TARGET("sse2")
+        void rollbackSSE2(double* V, int n, double pu, double pd) {
+            __m128d vu = _mm_set1_pd(pu), vd = _mm_set1_pd(pd);
+            int i = 0;
+            for (; i + 2 <= n; i += 2) {
+                __m128d lo = _mm_loadu_pd(V + i);
+                __m128d hi = _mm_loadu_pd(V + i + 1);
+                _mm_storeu_pd(V + i, _mm_add_pd(_mm_mul_pd(vu, hi), _mm_mul_pd(vd, lo)));
+            }
+            rollbackScalar(V + i, n - i, pu, pd);
+        }
+
+        CRR_TARGET("sse2")
+        void rollbackMaxSSE2(double* V, const double* E, int n, double pu, double pd) {
+            __m128d vu = _mm_set1_pd(pu), vd = _mm_set1_pd(pd);
+            int i = 0;
+            for (; i + 2 <= n; i += 2) {
+                __m128d lo = _mm_loadu_pd(V + i);
+                __m128d hi = _mm_loadu_pd(V + i + 1);
+                __m128d cont = _mm_add_pd(_mm_mul_pd(vu, hi), _mm_mul_pd(vd, lo));
+                _mm_storeu_pd(V + i, _mm_max_pd(_mm_loadu_pd(E + i), cont));
+            }
+            rollbackMaxScalar(V + i, E + i, n - i, pu, pd);
+        }
+
+        CRR_TARGET("sse2")
+        void stepSSE2(const double* next, double* cur, int n, double pu, double pd) {
+            __m128d vu = _mm_set1_pd(pu), vd = _mm_set1_pd(pd);
+            int i = 0;
+            for (; i + 2 <= n; i += 2) {
+                __m128d lo = _mm_loadu_pd(next + i);
+                __m128d hi = _mm_loadu_pd(next + i + 1);
+                _mm_storeu_pd(cur + i, _mm_add_pd(_mm_mul_pd(vu, hi), _mm_mul_pd(vd, lo)));
+            }
+            stepScalar(next + i, cur + i, n - i, pu, pd);
+        }
+
+        CRR_TARGET("sse2")
+        void stepMaxSSE2(const double* next, const double* E, double* cur, int n, double pu, double pd) {
+            __m128d vu = _mm_set1_pd(pu), vd = _mm_set1_pd(pd);
+            int i = 0;
+            for (; i + 2 <= n; i += 2) {
+                __m128d lo = _mm_loadu_pd(next + i);
+                __m128d hi = _mm_loadu_pd(next + i + 1);
+                __m128d cont = _mm_add_pd(_mm_mul_pd(vu, hi), _mm_mul_pd(vd, lo));
+                _mm_storeu_pd(cur + i, _mm_max_pd(_mm_loadu_pd(E + i), cont));
+            }
+            stepMaxScalar(next + i, E + i, cur + i, n - i, pu, pd);
+        }
+
+        CRR_TARGET("sse2")
+        void rollback3SSE2(double* V, int n, double pu, double pm, double pd) {
+            __m128d vu = _mm_set1_pd(pu), vm = _mm_set1_pd(pm), vd = _mm_set1_pd(pd);
+            int i = 0;
+            for (; i + 2 <= n; i += 2) {
+                __m128d lo = _mm_loadu_pd(V + i);
+                __m128d mid = _mm_loadu_pd(V + i + 1);
+                __m128d hi = _mm_loadu_pd(V + i + 2);
+                _mm_storeu_pd(V + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(vu, hi), _mm_mul_pd(vm, mid)), _mm_mul_pd(vd, lo)));
+            }
+            rollback3Scalar(V + i, n - i, pu, pm, pd);
+        }
+
+        CRR_TARGET("sse2")
+        void rollbackMax3SSE2(double* V, const double* E, int n, double pu, double pm, double pd) {
+            __m128d vu = _mm_set1_pd(pu), vm = _mm_set1_pd(pm), vd = _mm_set1_pd(pd);
+            int i = 0;
+            for (; i + 2 <= n; i += 2) {
+                __m128d lo = _mm_loadu_pd(V + i);
+                __m128d mid = _mm_loadu_pd(V + i + 1);
+                __m128d hi = _mm_loadu_pd(V + i + 2);
+                __m128d cont = _mm_add_pd(_mm_add_pd(_mm_mul_pd(vu, hi), _mm_mul_pd(vm, mid)), _mm_mul_pd(vd, lo));
+                _mm_storeu_pd(V + i, _mm_max_pd(_mm_loadu_pd(E + i), cont));
+            }
+            rollbackMax3Scalar(V + i, E + i, n - i, pu, pm, pd);
+        }
+
+        CRR_TARGET("sse2")
+        void step3SSE2(const double* next, double* cur, int n, double pu, double pm, double pd) {
+            __m128d vu = _mm_set1_pd(pu), vm = _mm_set1_pd(pm), vd = _mm_set1_pd(pd);
+            int i = 0;
+            for (; i + 2 <= n; i += 2) {
+                __m128d lo = _mm_loadu_pd(next + i);
+                __m128d mid = _mm_loadu_pd(next + i + 1);
+                __m128d hi = _mm_loadu_pd(next + i + 2);
+                _mm_storeu_pd(cur + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(vu, hi), _mm_mul_pd(vm, mid)), _mm_mul_pd(vd, lo)));
+            }
+            step3Scalar(next + i, cur + i, n - i, pu, pm, pd);
+        }
+
+        CRR_TARGET("sse2")
+        void stepMax3SSE2(const double* next, const double* E, double* cur, int n, double pu, double pm, double pd) {
+            __m128d vu = _mm_set1_pd(pu), vm = _mm_set1_pd(pm), vd = _mm_set1_pd(pd);
+            int i = 0;
+            for (; i + 2 <= n; i += 2) {
+                __m128d lo = _mm_loadu_pd(next + i);
+                __m128d mid = _mm_loadu_pd(next + i + 1);
+                __m128d hi = _mm_loadu_pd(next + i + 2);
+                __m128d cont = _mm_add_pd(_mm_add_pd(_mm_mul_pd(vu, hi), _mm_mul_pd(vm, mid)), _mm_mul_pd(vd, lo));
+                _mm_storeu_pd(cur + i, _mm_max_pd(_mm_loadu_pd(E + i), cont));
+            }
+            stepMax3Scalar(next + i, E + i, cur + i, n - i, pu, pm, pd);
+        }
+
+        CRR_TARGET("sse2")
+        void rollbackStridedSSE2(double* V, int n, int stride, double pu, double pd) {
+            __m128d vu = _mm_set1_pd(pu), vd = _mm_set1_pd(pd);
+            int j = 0;
+            for (; j + 2 <= n; j += 2) {
+                __m128d lo = _mm_loadu_pd(V + j);
+                __m128d hi = _mm_loadu_pd(V + j + stride);
+                _mm_storeu_pd(V + j, _mm_add_pd(_mm_mul_pd(vu, hi), _mm_mul_pd(vd, lo)));
+            }
+            rollbackStridedScalar(V + j, n - j, stride, pu, pd);
+        }
+
+        CRR_TARGET("sse2")
+        void rollbackMaxStrikesSSE2(double* V, const double* S, const double* K, int M, int n,
+            double pu, double pd, bool put)
+        {
+            __m128d vu = _mm_set1_pd(pu), vd = _mm_set1_pd(pd), zero = _mm_setzero_pd();
+            for (int i = 0; i < n; ++i) {
+                double* row = V + std::size_t(i) * M;
+                __m128d s = _mm_set1_pd(S[i]);
+                int m = 0;
+                for (; m + 2 <= M; m += 2) {
+                    __m128d k = _mm_loadu_pd(K + m);
+                    __m128d e = _mm_max_pd(put ? _mm_sub_pd(k, s) : _mm_sub_pd(s, k), zero);
+                    __m128d lo = _mm_loadu_pd(row + m);
+                    __m128d hi = _mm_loadu_pd(row + m + M);
+                    __m128d cont = _mm_add_pd(_mm_mul_pd(vu, hi), _mm_mul_pd(vd, lo));
+                    _mm_storeu_pd(row + m, _mm_max_pd(e, cont));
+                }
+                for (; m < M; ++m) {
+                    double e = put ? std::max<double>(K[m] - S[i], 0.0) : std::max<double>(S[i] - K[m], 0.0);
+                    row[m] = std::max<double>(e, pu * row[m + M] + pd * row[m]);
+                }
+            }
+        }
+
+        CRR_TARGET("sse2")
+        void callSSE2(const double* S, double K, double* out, int n) {
+            __m128d vk = _mm_set1_pd(K), zero = _mm_setzero_pd();
+            int i = 0;
+            for (; i + 2 <= n; i += 2)
+                _mm_storeu_pd(out + i, _mm_max_pd(_mm_sub_pd(_mm_loadu_pd(S + i), vk), zero));
+            callScalar(S + i, K, out + i, n - i);
+        }
+
+        CRR_TARGET("sse2")
+        void putSSE2(const double* S, double K, double* out, int n) {
+            __m128d vk = _mm_set1_pd(K), zero = _mm_setzero_pd();
+            int i = 0;
+            for (; i + 2 <= n; i += 2)
+                _mm_storeu_pd(out + i, _mm_max_pd(_mm_sub_pd(vk, _mm_loadu_pd(S + i)), zero));
+            putScalar(S + i, K, out + i, n - i);
+        }
+
+        CRR_TARGET("sse2")
+        double dotSSE2(const double* a, const double* b, int n) {
+            __m128d acc[4] = { _mm_setzero_pd(), _mm_setzero_pd(), _mm_setzero_pd(), _mm_setzero_pd() };
+            int i = 0;
+            for (; i + 8 <= n; i += 8)
+                for (int j = 0; j < 4; ++j)
+                    acc[j] = _mm_add_pd(acc[j], _mm_mul_pd(_mm_loadu_pd(a + i + 2 * j), _mm_loadu_pd(b + i + 2 * j)));
+            double s[8];
+            for (int j = 0; j < 4; ++j)
+                _mm_storeu_pd(s + 2 * j, acc[j]);
+            return dotTail(a, b, i, n, s);
+        }
+
+        //=====================================================================
+        // AVX2 (sans FMA pour rester identique au chemin scalaire)
+        //=====================================================================
+
+        CRR_TARGET("avx2")
+        void rollbackAVX2(double* V, int n, double pu, double pd) {
+            __m256d vu = _mm256_set1_pd(pu), vd = _mm256_set1_pd(pd);
+            int i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m256d lo = _mm256_loadu_pd(V + i);
+                __m256d hi = _mm256_loadu_pd(V + i + 1);
+                _mm256_storeu_pd(V + i, _mm256_add_pd(_mm256_mul_pd(vu, hi), _mm256_mul_pd(vd, lo)));
+            }
+            rollbackScalar(V + i, n - i, pu, pd);
+        }
+
+        CRR_TARGET("avx2")
+        void rollbackMaxAVX2(double* V, const double* E, int n, double pu, double pd) {
+            __m256d vu = _mm256_set1_pd(pu), vd = _mm256_set1_pd(pd);
+            int i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m256d lo = _mm256_loadu_pd(V + i);
+                __m256d hi = _mm256_loadu_pd(V + i + 1);
+                __m256d cont = _mm256_add_pd(_mm256_mul_pd(vu, hi), _mm256_mul_pd(vd, lo));
+                _mm256_storeu_pd(V + i, _mm256_max_pd(_mm256_loadu_pd(E + i), cont));
+            }
+            rollbackMaxScalar(V + i, E + i, n - i, pu, pd);
+        }
+
+        CRR_TARGET("avx2")
+        void stepAVX2(const double* next, double* cur, int n, double pu, double pd) {
+            __m256d vu = _mm256_set1_pd(pu), vd = _mm256_set1_pd(pd);
+            int i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m256d lo = _mm256_loadu_pd(next + i);
+                __m256d hi = _mm256_loadu_pd(next + i + 1);
+                _mm256_storeu_pd(cur + i, _mm256_add_pd(_mm256_mul_pd(vu, hi), _mm256_mul_pd(vd, lo)));
+            }
+            stepScalar(next + i, cur + i, n - i, pu, pd);
+        }
+
+        CRR_TARGET("avx2")
+        void stepMaxAVX2(const double* next, const double* E, double* cur, int n, double pu, double pd) {
+            __m256d vu = _mm256_set1_pd(pu), vd = _mm256_set1_pd(pd);
+            int i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m256d lo = _mm256_loadu_pd(next + i);
+                __m256d hi = _mm256_loadu_pd(next + i + 1);
+                __m256d cont = _mm256_add_pd(_mm256_mul_pd(vu, hi), _mm256_mul_pd(vd, lo));
+                _mm256_storeu_pd(cur + i, _mm256_max_pd(_mm256_loadu_pd(E + i), cont));
+            }
+            stepMaxScalar(next + i, E + i, cur + i, n - i, pu, pd);
+        }
+
+        CRR_TARGET("avx2")
+        void rollback3AVX2(double* V, int n, double pu, double pm, double pd) {
+            __m256d vu = _mm256_set1_pd(pu), vm = _mm256_set1_pd(pm), vd = _mm256_set1_pd(pd);
+            int i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m256d lo = _mm256_loadu_pd(V + i);
+                __m256d mid = _mm256_loadu_pd(V + i + 1);
+                __m256d hi = _mm256_loadu_pd(V + i + 2);
+                _mm256_storeu_pd(V + i, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(vu, hi), _mm256_mul_pd(vm, mid)), _mm256_mul_pd(vd, lo)));
+            }
+            // La fin scalaire peut être appelée hors ligne, encodée en SSE : sans vzeroupper,
+            // chaque instruction SSE paie la transition AVX/SSE.
+            _mm256_zeroupper();
+            rollback3Scalar(V + i, n - i, pu, pm, pd);
+        }
+
+        CRR_TARGET("avx2")
+        void rollbackMax3AVX2(double* V, const double* E, int n, double pu, double pm, double pd) {
+            __m256d vu = _mm256_set1_pd(pu), vm = _mm256_set1_pd(pm), vd = _mm256_set1_pd(pd);
+            int i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m256d lo = _mm256_loadu_pd(V + i);
+                __m256d mid = _mm256_loadu_pd(V + i + 1);
+                __m256d hi = _mm256_loadu_pd(V + i + 2);
+                __m256d cont = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(vu, hi), _mm256_mul_pd(vm, mid)), _mm256_mul_pd(vd, lo));
+                _mm256_storeu_pd(V + i, _mm256_max_pd(_mm256_loadu_pd(E + i), cont));
+            }
+            _mm256_zeroupper();
+            rollbackMax3Scalar(V + i, E + i, n - i, pu, pm, pd);
+        }
+
+        CRR_TARGET("avx2")
+        void step3AVX2(const double* next, double* cur, int n, double pu, double pm, double pd) {
+            __m256d vu = _mm256_set1_pd(pu), vm = _mm256_set1_pd(pm), vd = _mm256_set1_pd(pd);
+            int i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m256d lo = _mm256_loadu_pd(next + i);
+                __m256d mid = _mm256_loadu_pd(next + i + 1);
+                __m256d hi = _mm256_loadu_pd(next + i + 2);
+                _mm256_storeu_pd(cur + i, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(vu, hi), _mm256_mul_pd(vm, mid)), _mm256_mul_pd(vd, lo)));
+            }
+            _mm256_zeroupper();
+            step3Scalar(next + i, cur + i, n - i, pu, pm, pd);
+        }
+
+        CRR_TARGET("avx2")
+        void stepMax3AVX2(const double* next, const double* E, double* cur, int n, double pu, double pm, double pd) {
+            __m256d vu = _mm256_set1_pd(pu), vm = _mm256_set1_pd(pm), vd = _mm256_set1_pd(pd);
+            int i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m256d lo = _mm256_loadu_pd(next + i);
+                __m256d mid = _mm256_loadu_pd(next + i + 1);
+                __m256d hi = _mm256_loadu_pd(next + i + 2);
+                __m256d cont = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(vu, hi), _mm256_mul_pd(vm, mid)), _mm256_mul_pd(vd, lo));
+                _mm256_storeu_pd(cur + i, _mm256_max_pd(_mm256_loadu_pd(E + i), cont));
+            }
+            _mm256_zeroupper();
+            stepMax3Scalar(next + i, E + i, cur + i, n - i, pu, pm, pd);
+        }
+
+        CRR_TARGET("avx2")
+        void rollbackStridedAVX2(double* V, int n, int stride, double pu, double pd) {
+            __m256d vu = _mm256_set1_pd(pu), vd = _mm256_set1_pd(pd);
+            int j = 0;
+            for (; j + 4 <= n; j += 4) {
+                __m256d lo = _mm256_loadu_pd(V + j);
+                __m256d hi = _mm256_loadu_pd(V + j + stride);
+                _mm256_storeu_pd(V + j, _mm256_add_pd(_mm256_mul_pd(vu, hi), _mm256_mul_pd(vd, lo)));
+            }
+            _mm256_zeroupper();
+            rollbackStridedScalar(V + j, n - j, stride, pu, pd);
+        }
+
+        CRR_TARGET("avx2")
+        void rollbackMaxStrikesAVX2(double* V, const double* S, const double* K, int M, int n,
+            double pu, double pd, bool put)
+        {
+            __m256d vu = _mm256_set1_pd(pu), vd = _mm256_set1_pd(pd), zero = _mm256_setzero_pd();
+            for (int i = 0; i < n; ++i) {
+                double* row = V + std::size_t(i) * M;
+                __m256d s = _mm256_set1_pd(S[i]);
+                int m = 0;
+                for (; m + 4 <= M; m += 4) {
+                    __m256d k = _mm256_loadu_pd(K + m);
+                    __m256d e = _mm256_max_pd(put ? _mm256_sub_pd(k, s) : _mm256_sub_pd(s, k), zero);
+                    __m256d lo = _mm256_loadu_pd(row + m);
+                    __m256d hi = _mm256_loadu_pd(row + m + M);
+                    __m256d cont = _mm256_add_pd(_mm256_mul_pd(vu, hi), _mm256_mul_pd(vd, lo));
+                    _mm256_storeu_pd(row + m, _mm256_max_pd(e, cont));
+                }
+                for (; m < M; ++m) {
+                    double e = put ? std::max<double>(K[m] - S[i], 0.0) : std::max<double>(S[i] - K[m], 0.0);
+                    row[m] = std::max<double>(e, pu * row[m + M] + pd * row[m]);
+                }
+            }
+        }
+
+        CRR_TARGET("avx2")
+        void callAVX2(const double* S, double K, double* out, int n) {
+            __m256d vk = _mm256_set1_pd(K), zero = _mm256_setzero_pd();
+            int i = 0;
+            for (; i + 4 <= n; i += 4)
+                _mm256_storeu_pd(out + i, _mm256_max_pd(_mm256_sub_pd(_mm256_loadu_pd(S + i), vk), zero));
+            callScalar(S + i, K, out + i, n - i);
+        }
+
+        CRR_TARGET("avx2")
+        void putAVX2(const double* S, double K, double* out, int n) {
+            __m256d vk = _mm256_set1_pd(K), zero = _mm256_setzero_pd();
+            int i = 0;
+            for (; i + 4 <= n; i += 4)
+                _mm256_storeu_pd(out + i, _mm256_max_pd(_mm256_sub_pd(vk, _mm256_loadu_pd(S + i)), zero));
+            putScalar(S + i, K, out + i, n - i);
+        }
+
+        CRR_TARGET("avx2")
+        double dotAVX2(const double* a, const double* b, int n) {
+            __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+            int i = 0;
+            for (; i + 8 <= n; i += 8) {
+                acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+                acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4)));
+            }
+            double s[8];
+            _mm256_storeu_pd(s, acc0);
+            _mm256_storeu_pd(s + 4, acc1);
+            return dotTail(a, b, i, n, s);
+        }
+
+        CRR_TARGET("avx2")
+        inline __m256d uniformAVX2(__m256i hi, __m256i lo) {
+            __m256i x = _mm256_or_si256(_mm256_slli_epi64(hi, 32), lo);
+            __m256d d = _mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(x, 12), _mm256_set1_epi64x(oneBits)));
+            return _mm256_add_pd(_mm256_sub_pd(d, _mm256_set1_pd(1.0)), _mm256_set1_pd(halfUlp));
+        }
+
+        CRR_TARGET("avx2")
+        inline __m256d expAVX2(__m256d x) {
+            x = _mm256_min_pd(_mm256_max_pd(x, _mm256_set1_pd(-708.0)), _mm256_set1_pd(709.0));
+            __m256d magic = _mm256_set1_pd(roundMagic);
+            __m256d t = _mm256_add_pd(_mm256_mul_pd(x, _mm256_set1_pd(log2e)), magic);
+            __m256d k = _mm256_sub_pd(t, magic);
+            __m256d r = _mm256_sub_pd(_mm256_sub_pd(x, _mm256_mul_pd(k, _mm256_set1_pd(ln2Hi))),
+                _mm256_mul_pd(k, _mm256_set1_pd(ln2Lo)));
+            __m256d p = _mm256_set1_pd(expCoef[0]);
+            for (int c = 1; c < 14; ++c)
+                p = _mm256_add_pd(_mm256_mul_pd(p, r), _mm256_set1_pd(expCoef[c]));
+            __m256i e = _mm256_slli_epi64(_mm256_add_epi64(_mm256_castpd_si256(t), _mm256_set1_epi64x(1023)), 52);
+            return _mm256_mul_pd(p, _mm256_castsi256_pd(e));
+        }
+
+        CRR_TARGET("avx2")
+        inline __m256d logAVX2(__m256d x) {
+            __m256i b = _mm256_castpd_si256(x);
+            __m256d one = _mm256_set1_pd(1.0);
+            __m256d e = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(b, 52),
+                _mm256_set1_epi64x(0x4330000000000000ll))), _mm256_set1_pd(4503599627371519.0));
+            __m256d m = _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(b, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFll)),
+                _mm256_set1_epi64x(oneBits)));
+            __m256d big = _mm256_cmp_pd(m, _mm256_set1_pd(sqrt2), _CMP_GT_OQ);
+            m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), big);
+            e = _mm256_add_pd(e, _mm256_and_pd(big, one));
+            __m256d f = _mm256_sub_pd(m, one);
+            __m256d s = _mm256_div_pd(f, _mm256_add_pd(_mm256_set1_pd(2.0), f));
+            __m256d s2 = _mm256_mul_pd(s, s);
+            __m256d p = _mm256_set1_pd(logCoef[0]);
+            for (int c = 1; c < 10; ++c)
+                p = _mm256_add_pd(_mm256_mul_pd(p, s2), _mm256_set1_pd(logCoef[c]));
+            __m256d t = _mm256_add_pd(s, s);
+            __m256d logm = _mm256_add_pd(t, _mm256_mul_pd(t, _mm256_mul_pd(s2, p)));
+            return _mm256_add_pd(_mm256_mul_pd(e, _mm256_set1_pd(ln2Hi)),
+                _mm256_add_pd(_mm256_mul_pd(e, _mm256_set1_pd(ln2Lo)), logm));
+        }
+
+        CRR_TARGET("avx2")
+        inline void sinCosTurnsAVX2(__m256d u, __m256d& c, __m256d& s) {
+            __m256d magic = _mm256_set1_pd(roundMagic);
+            __m256d u4 = _mm256_mul_pd(u, _mm256_set1_pd(4.0));
+            __m256d q = _mm256_sub_pd(_mm256_add_pd(u4, magic), magic);
+            __m256d t = _mm256_mul_pd(_mm256_sub_pd(u4, q), _mm256_set1_pd(halfPi));
+            __m256d t2 = _mm256_mul_pd(t, t);
+            __m256d ps = _mm256_set1_pd(sinCoef[0]);
+            for (int k = 1; k < 8; ++k)
+                ps = _mm256_add_pd(_mm256_mul_pd(ps, t2), _mm256_set1_pd(sinCoef[k]));
+            __m256d pc = _mm256_set1_pd(cosCoef[0]);
+            for (int k = 1; k < 9; ++k)
+                pc = _mm256_add_pd(_mm256_mul_pd(pc, t2), _mm256_set1_pd(cosCoef[k]));
+            __m256d sn = _mm256_sub_pd(t, _mm256_mul_pd(t, _mm256_mul_pd(t2, ps)));
+            __m256d cs = _mm256_sub_pd(_mm256_set1_pd(1.0), _mm256_mul_pd(t2, pc));
+            __m256d q1 = _mm256_cmp_pd(q, _mm256_set1_pd(1.0), _CMP_EQ_OQ);
+            __m256d q2 = _mm256_cmp_pd(q, _mm256_set1_pd(2.0), _CMP_EQ_OQ);
+            __m256d q3 = _mm256_cmp_pd(q, _mm256_set1_pd(3.0), _CMP_EQ_OQ);
+            __m256d swap = _mm256_or_pd(q1, q3);
+            __m256d a = _mm256_blendv_pd(cs, sn, swap), b = _mm256_blendv_pd(sn, cs, swap);
+            __m256d sign = _mm256_set1_pd(-0.0);
+            c = _mm256_xor_pd(a, _mm256_and_pd(_mm256_or_pd(q1, q2), sign));
+            s = _mm256_xor_pd(b, _mm256_and_pd(_mm256_or_pd(q2, q3), sign));
+        }
+
+        CRR_TARGET("avx2")
+        void normalPairsAVX2(std::uint64_t seed, std::uint64_t path0, std::uint32_t pair, double* z0, double* z1, int n) {
+            std::uint32_t k0[10], k1[10];
+            philoxKeys(seed, k0, k1);
+            // Un mot de 32 bits de Philox par voie de 64 bits : _mm256_mul_epu32 donne le produit complet
+            const __m256i low = _mm256_set1_epi64x(0xFFFFFFFFll);
+            const __m256i M0 = _mm256_set1_epi64x(0xD2511F53ll), M1 = _mm256_set1_epi64x(0xCD9E8D57ll);
+            const __m256i lane = _mm256_set_epi64x(3, 2, 1, 0);
+            int i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m256i path = _mm256_add_epi64(_mm256_set1_epi64x(static_cast<long long>(path0 + i)), lane);
+                __m256i c0 = _mm256_set1_epi64x(pair), c1 = _mm256_and_si256(path, low);
+                __m256i c2 = _mm256_srli_epi64(path, 32), c3 = _mm256_setzero_si256();
+                for (int r = 0; r < 10; ++r) {
+                    __m256i p0 = _mm256_mul_epu32(M0, c0), p1 = _mm256_mul_epu32(M1, c2);
+                    c0 = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(p1, 32), c1), _mm256_set1_epi64x(k0[r]));
+                    c1 = _mm256_and_si256(p1, low);
+                    c2 = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(p0, 32), c3), _mm256_set1_epi64x(k1[r]));
+                    c3 = _mm256_and_si256(p0, low);
+                }
+                __m256d radius = _mm256_sqrt_pd(_mm256_mul_pd(_mm256_set1_pd(-2.0), logAVX2(uniformAVX2(c0, c1))));
+                __m256d c, s;
+                sinCosTurnsAVX2(uniformAVX2(c2, c3), c, s);
+                _mm256_storeu_pd(z0 + i, _mm256_mul_pd(radius, c));
+                _mm256_storeu_pd(z1 + i, _mm256_mul_pd(radius, s));
+            }
+            _mm256_zeroupper();
+            normalPairsScalar(seed, path0 + i, pair, z0 + i, z1 + i, n - i);
+        }
+
+        CRR_TARGET("avx2")
+        void gbmStepAVX2(const double* S, const double* Z, double* next, int n, double drift, double vol) {
+            __m256d vd = _mm256_set1_pd(drift), vv = _mm256_set1_pd(vol);
+            int i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m256d x = _mm256_add_pd(vd, _mm256_mul_pd(vv, _mm256_loadu_pd(Z + i)));
+                _mm256_storeu_pd(next + i, _mm256_mul_pd(_mm256_loadu_pd(S + i), expAVX2(x)));
+            }
+            _mm256_zeroupper();
+            gbmStepScalar(S + i, Z + i, next + i, n - i, drift, vol);
+        }
+
+        CRR_TARGET("avx2")
+        void inverseNormalAVX2(const double* u, double* z, int n) {
+            const __m256d half = _mm256_set1_pd(0.5), one = _mm256_set1_pd(1.0);
+            const __m256d low = _mm256_set1_pd(acklamLow), high = _mm256_set1_pd(1.0 - acklamLow);
+            int i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m256d x = _mm256_loadu_pd(u + i);
+                __m256d r = _mm256_sub_pd(x, half), r2 = _mm256_mul_pd(r, r);
+                __m256d pa = _mm256_set1_pd(acklamA[0]), pb = _mm256_set1_pd(acklamB[0]);
+                for (int k = 1; k < 6; ++k) {
+                    pa = _mm256_add_pd(_mm256_mul_pd(pa, r2), _mm256_set1_pd(acklamA[k]));
+                    pb = _mm256_add_pd(_mm256_mul_pd(pb, r2), _mm256_set1_pd(acklamB[k]));
+                }
+                __m256d y = _mm256_div_pd(_mm256_mul_pd(pa, r), pb);
+                __m256d tails = _mm256_or_pd(_mm256_cmp_pd(x, low, _CMP_LT_OQ), _mm256_cmp_pd(x, high, _CMP_GT_OQ));
+                // Queues calculées seulement si une voie y tombe
+                if (_mm256_movemask_pd(tails)) {
+                    __m256d t = _mm256_sqrt_pd(_mm256_mul_pd(_mm256_set1_pd(-2.0),
+                        logAVX2(_mm256_min_pd(x, _mm256_sub_pd(one, x)))));
+                    __m256d pc = _mm256_set1_pd(acklamC[0]), pd = _mm256_set1_pd(acklamD[0]);
+                    for (int k = 1; k < 6; ++k)
+                        pc = _mm256_add_pd(_mm256_mul_pd(pc, t), _mm256_set1_pd(acklamC[k]));
+                    for (int k = 1; k < 5; ++k)
+                        pd = _mm256_add_pd(_mm256_mul_pd(pd, t), _mm256_set1_pd(acklamD[k]));
+                    __m256d tail = _mm256_div_pd(pc, pd);
+                    __m256d upper = _mm256_cmp_pd(x, half, _CMP_GT_OQ);
+                    tail = _mm256_blendv_pd(tail, _mm256_sub_pd(_mm256_setzero_pd(), tail), upper);
+                    y = _mm256_blendv_pd(y, tail, tails);
+                }
+                _mm256_storeu_pd(z + i, y);
+            }
+            _mm256_zeroupper();
+            inverseNormalScalar(u + i, z + i, n - i);
+        }
+
+        //=====================================================================
+        // AVX-512F
+        //=====================================================================
+
+        CRR_TARGET("avx512f")
+        void rollbackAVX512(double* V, int n, double pu, double pd) {
+            __m512d vu = _mm512_set1_pd(pu), vd = _mm512_set1_pd(pd);
+            int i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m512d lo = _mm512_loadu_pd(V + i);
+                __m512d hi = _mm512_loadu_pd(V + i + 1);
+                _mm512_storeu_pd(V + i, _mm512_add_pd(_mm512_mul_pd(vu, hi), _mm512_mul_pd(vd, lo)));
+            }
+            rollbackScalar(V + i, n - i, pu, pd);
+        }
+
+        CRR_TARGET("avx512f")
+        void rollbackMaxAVX512(double* V, const double* E, int n, double pu, double pd) {
+            __m512d vu = _mm512_set1_pd(pu), vd = _mm512_set1_pd(pd);
+            int i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m512d lo = _mm512_loadu_pd(V + i);
+                __m512d hi = _mm512_loadu_pd(V + i + 1);
+                __m512d cont = _mm512_add_pd(_mm512_mul_pd(vu, hi), _mm512_mul_pd(vd, lo));
+                _mm512_storeu_pd(V + i, _mm512_max_pd(_mm512_loadu_pd(E + i), cont));
+            }
+            rollbackMaxScalar(V + i, E + i, n - i, pu, pd);
+        }
+
+        CRR_TARGET("avx512f")
+        void stepAVX512(const double* next, double* cur, int n, double pu, double pd) {
+            __m512d vu = _mm512_set1_pd(pu), vd = _mm512_set1_pd(pd);
+            int i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m512d lo = _mm512_loadu_pd(next + i);
+                __m512d hi = _mm512_loadu_pd(next + i + 1);
+                _mm512_storeu_pd(cur + i, _mm512_add_pd(_mm512_mul_pd(vu, hi), _mm512_mul_pd(vd, lo)));
+            }
+            stepScalar(next + i, cur + i, n - i, pu, pd);
+        }
+
+        CRR_TARGET("avx512f")
+        void stepMaxAVX512(const double* next, const double* E, double* cur, int n, double pu, double pd) {
+            __m512d vu = _mm512_set1_pd(pu), vd = _mm512_set1_pd(pd);
+            int i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m512d lo = _mm512_loadu_pd(next + i);
+                __m512d hi = _mm512_loadu_pd(next + i + 1);
+                __m512d cont = _mm512_add_pd(_mm512_mul_pd(vu, hi), _mm512_mul_pd(vd, lo));
+                _mm512_storeu_pd(cur + i, _mm512_max_pd(_mm512_loadu_pd(E + i), cont));
+            }
+            stepMaxScalar(next + i, E + i, cur + i, n - i, pu, pd);
+        }
+
+        CRR_TARGET("avx512f")
+        void rollback3AVX512(double* V, int n, double pu, double pm, double pd) {
+            __m512d vu = _mm512_set1_pd(pu), vm = _mm512_set1_pd(pm), vd = _mm512_set1_pd(pd);
+            int i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m512d lo = _mm512_loadu_pd(V + i);
+                __m512d mid = _mm512_loadu_pd(V + i + 1);
+                __m512d hi = _mm512_loadu_pd(V + i + 2);
+                _mm512_storeu_pd(V + i, _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(vu, hi), _mm512_mul_pd(vm, mid)), _mm512_mul_pd(vd, lo)));
+            }
+            _mm256_zeroupper();
+            rollback3Scalar(V + i, n - i, pu, pm, pd);
+        }
+
+        CRR_TARGET("avx512f")
+        void rollbackMax3AVX512(double* V, const double* E, int n, double pu, double pm, double pd) {
+            __m512d vu = _mm512_set1_pd(pu), vm = _mm512_set1_pd(pm), vd = _mm512_set1_pd(pd);
+            int i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m512d lo = _mm512_loadu_pd(V + i);
+                __m512d mid = _mm512_loadu_pd(V + i + 1);
+                __m512d hi = _mm512_loadu_pd(V + i + 2);
+                __m512d cont = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(vu, hi), _mm512_mul_pd(vm, mid)), _mm512_mul_pd(vd, lo));
+                _mm512_storeu_pd(V + i, _mm512_max_pd(_mm512_loadu_pd(E + i), cont));
+            }
+            _mm256_zeroupper();
+            rollbackMax3Scalar(V + i, E + i, n - i, pu, pm, pd);
+        }
+
+        CRR_TARGET("avx512f")
+        void step3AVX512(const double* next, double* cur, int n, double pu, double pm, double pd) {
+            __m512d vu = _mm512_set1_pd(pu), vm = _mm512_set1_pd(pm), vd = _mm512_set1_pd(pd);
+            int i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m512d lo = _mm512_loadu_pd(next + i);
+                __m512d mid = _mm512_loadu_pd(next + i + 1);
+                __m512d hi = _mm512_loadu_pd(next + i + 2);
+                _mm512_storeu_pd(cur + i, _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(vu, hi), _mm512_mul_pd(vm, mid)), _mm512_mul_pd(vd, lo)));
+            }
+            _mm256_zeroupper();
+            step3Scalar(next + i, cur + i, n - i, pu, pm, pd);
+        }
+
+        CRR_TARGET("avx512f")
+        void stepMax3AVX512(const double* next, const double* E, double* cur, int n, double pu, double pm, double pd) {
+            __m512d vu = _mm512_set1_pd(pu), vm = _mm512_set1_pd(pm), vd = _mm512_set1_pd(pd);
+            int i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m512d lo = _mm512_loadu_pd(next + i);
+                __m512d mid = _mm512_loadu_pd(next + i + 1);
+                __m512d hi = _mm512_loadu_pd(next + i + 2);
+                __m512d cont = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(vu, hi), _mm512_mul_pd(vm, mid)), _mm512_mul_pd(vd, lo));
+                _mm512_storeu_pd(cur + i, _mm512_max_pd(_mm512_loadu_pd(E + i), cont));
+            }
+            _mm256_zeroupper();
+            stepMax3Scalar(next + i, E + i, cur + i, n - i, pu, pm, pd);
+        }
+
+        CRR_TARGET("avx512f")
+        void rollbackStridedAVX512(double* V, int n, int stride, double pu, double pd) {
+            __m512d vu = _mm512_set1_pd(pu), vd = _mm512_set1_pd(pd);
+            int j = 0;
+            for (; j + 8 <= n; j += 8) {
+                __m512d lo = _mm512_loadu_pd(V + j);
+                __m512d hi = _mm512_loadu_pd(V + j + stride);
+                _mm512_storeu_pd(V + j, _mm512_add_pd(_mm512_mul_pd(vu, hi), _mm512_mul_pd(vd, lo)));
+            }
+            _mm256_zeroupper();
+            rollbackStridedScalar(V + j, n - j, stride, pu, pd);
+        }
+
+        CRR_TARGET("avx512f")
+        void rollbackMaxStrikesAVX512(double* V, const double* S, const double* K, int M, int n,
+            double pu, double pd, bool put)
+        {
+            __m512d vu = _mm512_set1_pd(pu), vd = _mm512_set1_pd(pd), zero = _mm512_setzero_pd();
+            for (int i = 0; i < n; ++i) {
+                double* row = V + std::size_t(i) * M;
+                __m512d s = _mm512_set1_pd(S[i]);
+                int m = 0;
+                for (; m + 8 <= M; m += 8) {
+                    __m512d k = _mm512_loadu_pd(K + m);
+                    __m512d e = _mm512_max_pd(put ? _mm512_sub_pd(k, s) : _mm512_sub_pd(s, k), zero);
+                    __m512d lo = _mm512_loadu_pd(row + m);
+                    __m512d hi = _mm512_loadu_pd(row + m + M);
+                    __m512d cont = _mm512_add_pd(_mm512_mul_pd(vu, hi), _mm512_mul_pd(vd, lo));
+                    _mm512_storeu_pd(row + m, _mm512_max_pd(e, cont));
+                }
+                for (; m < M; ++m) {
+                    double e = put ? std::max<double>(K[m] - S[i], 0.0) : std::max<double>(S[i] - K[m], 0.0);
+                    row[m] = std::max<double>(e, pu * row[m + M] + pd * row[m]);
+                }
+            }
+        }
+
+        CRR_TARGET("avx512f")
+        void callAVX512(const double* S, double K, double* out, int n) {
+            __m512d vk = _mm512_set1_pd(K), zero = _mm512_setzero_pd();
+            int i = 0;
+            for (; i + 8 <= n; i += 8)
+                _mm512_storeu_pd(out + i, _mm512_max_pd(_mm512_sub_pd(_mm512_loadu_pd(S + i), vk), zero));
+            callScalar(S + i, K, out + i, n - i);
+        }
+
+        CRR_TARGET("avx512f")
+        void putAVX512(const double* S, double K, double* out, int n) {
+            __m512d vk = _mm512_set1_pd(K), zero = _mm512_setzero_pd();
+            int i = 0;
+            for (; i + 8 <= n; i += 8)
+                _mm512_storeu_pd(out + i, _mm512_max_pd(_mm512_sub_pd(vk, _mm512_loadu_pd(S + i)), zero));
+            putScalar(S + i, K, out + i, n - i);
+        }
+
+        CRR_TARGET("avx512f")
+        double dotAVX512(const double* a, const double* b, int n) {
+            __m512d acc = _mm512_setzero_pd();
+            int i = 0;
+            for (; i + 8 <= n; i += 8)
+                acc = _mm512_add_pd(acc, _mm512_mul_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+            double s[8];
+            _mm512_storeu_pd(s, acc);
+            return dotTail(a, b, i, n, s);
+        }
+
+        CRR_TARGET("avx512f")
+        inline __m512d uniformAVX512(__m512i hi, __m512i lo) {
+            __m512i x = _mm512_or_si512(_mm512_slli_epi64(hi, 32), lo);
+            __m512d d = _mm512_castsi512_pd(_mm512_or_si512(_mm512_srli_epi64(x, 12), _mm512_set1_epi64(oneBits)));
+            return _mm512_add_pd(_mm512_sub_pd(d, _mm512_set1_pd(1.0)), _mm512_set1_pd(halfUlp));
+        }
+
+        CRR_TARGET("avx512f")
+        inline __m512d expAVX512(__m512d x) {
+            x = _mm512_min_pd(_mm512_max_pd(x, _mm512_set1_pd(-708.0)), _mm512_set1_pd(709.0));
+            __m512d magic = _mm512_set1_pd(roundMagic);
+            __m512d t = _mm512_add_pd(_mm512_mul_pd(x, _mm512_set1_pd(log2e)), magic);
+            __m512d k = _mm512_sub_pd(t, magic);
+            __m512d r = _mm512_sub_pd(_mm512_sub_pd(x, _mm512_mul_pd(k, _mm512_set1_pd(ln2Hi))),
+                _mm512_mul_pd(k, _mm512_set1_pd(ln2Lo)));
+            __m512d p = _mm512_set1_pd(expCoef[0]);
+            for (int c = 1; c < 14; ++c)
+                p = _mm512_add_pd(_mm512_mul_pd(p, r), _mm512_set1_pd(expCoef[c]));
+            __m512i e = _mm512_slli_epi64(_mm512_add_epi64(_mm512_castpd_si512(t), _mm512_set1_epi64(1023)), 52);
+            return _mm512_mul_pd(p, _mm512_castsi512_pd(e));
+        }
+
+        CRR_TARGET("avx512f")
+        inline __m512d logAVX512(__m512d x) {
+            __m512i b = _mm512_castpd_si512(x);
+            __m512d one = _mm512_set1_pd(1.0);
+            __m512d e = _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(_mm512_srli_epi64(b, 52),
+                _mm512_set1_epi64(0x4330000000000000ll))), _mm512_set1_pd(4503599627371519.0));
+            __m512d m = _mm512_castsi512_pd(_mm512_or_si512(_mm512_and_si512(b, _mm512_set1_epi64(0x000FFFFFFFFFFFFFll)),
+                _mm512_set1_epi64(oneBits)));
+            __mmask8 big = _mm512_cmp_pd_mask(m, _mm512_set1_pd(sqrt2), _CMP_GT_OQ);
+            m = _mm512_mask_mul_pd(m, big, m, _mm512_set1_pd(0.5));
+            e = _mm512_mask_add_pd(e, big, e, one);
+            __m512d f = _mm512_sub_pd(m, one);
+            __m512d s = _mm512_div_pd(f, _mm512_add_pd(_mm512_set1_pd(2.0), f));
+            __m512d s2 = _mm512_mul_pd(s, s);
+            __m512d p = _mm512_set1_pd(logCoef[0]);
+            for (int c = 1; c < 10; ++c)
+                p = _mm512_add_pd(_mm512_mul_pd(p, s2), _mm512_set1_pd(logCoef[c]));
+            __m512d t = _mm512_add_pd(s, s);
+            __m512d logm = _mm512_add_pd(t, _mm512_mul_pd(t, _mm512_mul_pd(s2, p)));
+            return _mm512_add_pd(_mm512_mul_pd(e, _mm512_set1_pd(ln2Hi)),
+                _mm512_add_pd(_mm512_mul_pd(e, _mm512_set1_pd(ln2Lo)), logm));
+        }
+
+        CRR_TARGET("avx512f")
+        inline void sinCosTurnsAVX512(__m512d u, __m512d& c, __m512d& s) {
+            __m512d magic = _mm512_set1_pd(roundMagic);
+            __m512d u4 = _mm512_mul_pd(u, _mm512_set1_pd(4.0));
+            __m512d q = _mm512_sub_pd(_mm512_add_pd(u4, magic), magic);
+            __m512d t = _mm512_mul_pd(_mm512_sub_pd(u4, q), _mm512_set1_pd(halfPi));
+            __m512d t2 = _mm512_mul_pd(t, t);
+            __m512d ps = _mm512_set1_pd(sinCoef[0]);
+            for (int k = 1; k < 8; ++k)
+                ps = _mm512_add_pd(_mm512_mul_pd(ps, t2), _mm512_set1_pd(sinCoef[k]));
+            __m512d pc = _mm512_set1_pd(cosCoef[0]);
+            for (int k = 1; k < 9; ++k)
+                pc = _mm512_add_pd(_mm512_mul_pd(pc, t2), _mm512_set1_pd(cosCoef[k]));
+            __m512d sn = _mm512_sub_pd(t, _mm512_mul_pd(t, _mm512_mul_pd(t2, ps)));
+            __m512d cs = _mm512_sub_pd(_mm512_set1_pd(1.0), _mm512_mul_pd(t2, pc));
+            __mmask8 q1 = _mm512_cmp_pd_mask(q, _mm512_set1_pd(1.0), _CMP_EQ_OQ);
+            __mmask8 q2 = _mm512_cmp_pd_mask(q, _mm512_set1_pd(2.0), _CMP_EQ_OQ);
+            __mmask8 q3 = _mm512_cmp_pd_mask(q, _mm512_set1_pd(3.0), _CMP_EQ_OQ);
+            __mmask8 swap = __mmask8(q1 | q3);
+            __m512i a = _mm512_castpd_si512(_mm512_mask_blend_pd(swap, cs, sn));
+            __m512i b = _mm512_castpd_si512(_mm512_mask_blend_pd(swap, sn, cs));
+            __m512i sign = _mm512_set1_epi64(static_cast<long long>(0x8000000000000000ull));
+            c = _mm512_castsi512_pd(_mm512_mask_xor_epi64(a, __mmask8(q1 | q2), a, sign));
+            s = _mm512_castsi512_pd(_mm512_mask_xor_epi64(b, __mmask8(q2 | q3), b, sign));
+        }
+
+        CRR_TARGET("avx512f")
+        void normalPairsAVX512(std::uint64_t seed, std::uint64_t path0, std::uint32_t pair, double* z0, double* z1, int n) {
+            std::uint32_t k0[10], k1[10];
+            philoxKeys(seed, k0, k1);
+            const __m512i low = _mm512_set1_epi64(0xFFFFFFFFll);
+            const __m512i M0 = _mm512_set1_epi64(0xD2511F53ll), M1 = _mm512_set1_epi64(0xCD9E8D57ll);
+            const __m512i lane = _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+            int i = 0;
+            // Deux groupes de 8 trajectoires entrelacés : leurs tours de Philox se recouvrent
+            for (; i + 16 <= n; i += 16) {
+                __m512i pathA = _mm512_add_epi64(_mm512_set1_epi64(static_cast<long long>(path0 + i)), lane);
+                __m512i pathB = _mm512_add_epi64(pathA, _mm512_set1_epi64(8));
+                __m512i a0 = _mm512_set1_epi64(pair), a1 = _mm512_and_si512(pathA, low);
+                __m512i a2 = _mm512_srli_epi64(pathA, 32), a3 = _mm512_setzero_si512();
+                __m512i b0 = a0, b1 = _mm512_and_si512(pathB, low);
+                __m512i b2 = _mm512_srli_epi64(pathB, 32), b3 = a3;
+                for (int r = 0; r < 10; ++r) {
+                    __m512i ka = _mm512_set1_epi64(k0[r]), kb = _mm512_set1_epi64(k1[r]);
+                    __m512i p0 = _mm512_mul_epu32(M0, a0), p1 = _mm512_mul_epu32(M1, a2);
+                    __m512i q0 = _mm512_mul_epu32(M0, b0), q1 = _mm512_mul_epu32(M1, b2);
+                    a0 = _mm512_xor_si512(_mm512_xor_si512(_mm512_srli_epi64(p1, 32), a1), ka);
+                    a1 = _mm512_and_si512(p1, low);
+                    a2 = _mm512_xor_si512(_mm512_xor_si512(_mm512_srli_epi64(p0, 32), a3), kb);
+                    a3 = _mm512_and_si512(p0, low);
+                    b0 = _mm512_xor_si512(_mm512_xor_si512(_mm512_srli_epi64(q1, 32), b1), ka);
+                    b1 = _mm512_and_si512(q1, low);
+                    b2 = _mm512_xor_si512(_mm512_xor_si512(_mm512_srli_epi64(q0, 32), b3), kb);
+                    b3 = _mm512_and_si512(q0, low);
+                }
+                __m512d ra = _mm512_sqrt_pd(_mm512_mul_pd(_mm512_set1_pd(-2.0), logAVX512(uniformAVX512(a0, a1))));
+                __m512d rb = _mm512_sqrt_pd(_mm512_mul_pd(_mm512_set1_pd(-2.0), logAVX512(uniformAVX512(b0, b1))));
+                __m512d ca, sa, cb, sb;
+                sinCosTurnsAVX512(uniformAVX512(a2, a3), ca, sa);
+                sinCosTurnsAVX512(uniformAVX512(b2, b3), cb, sb);
+                _mm512_storeu_pd(z0 + i, _mm512_mul_pd(ra, ca));
+                _mm512_storeu_pd(z1 + i, _mm512_mul_pd(ra, sa));
+                _mm512_storeu_pd(z0 + i + 8, _mm512_mul_pd(rb, cb));
+                _mm512_storeu_pd(z1 + i + 8, _mm512_mul_pd(rb, sb));
+            }
+            _mm256_zeroupper();
+            normalPairsScalar(seed, path0 + i, pair, z0 + i, z1 + i, n - i);
+        }
+
+        CRR_TARGET("avx512f")
+        void gbmStepAVX512(const double* S, const double* Z, double* next, int n, double drift, double vol) {
+            __m512d vd = _mm512_set1_pd(drift), vv = _mm512_set1_pd(vol);
+            int i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m512d x = _mm512_add_pd(vd, _mm512_mul_pd(vv, _mm512_loadu_pd(Z + i)));
+                _mm512_storeu_pd(next + i, _mm512_mul_pd(_mm512_loadu_pd(S + i), expAVX512(x)));
+            }
+            _mm256_zeroupper();
+            gbmStepScalar(S + i, Z + i, next + i, n - i, drift, vol);
+        }
+
+        CRR_TARGET("avx512f")
+        void inverseNormalAVX512(const double* u, double* z, int n) {
+            const __m512d half = _mm512_set1_pd(0.5), one = _mm512_set1_pd(1.0);
+            const __m512d low = _mm512_set1_pd(acklamLow), high = _mm512_set1_pd(1.0 - acklamLow);
+            int i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m512d x = _mm512_loadu_pd(u + i);
+                __m512d r = _mm512_sub_pd(x, half), r2 = _mm512_mul_pd(r, r);
+                __m512d pa = _mm512_set1_pd(acklamA[0]), pb = _mm512_set1_pd(acklamB[0]);
+                for (int k = 1; k < 6; ++k) {
+                    pa = _mm512_add_pd(_mm512_mul_pd(pa, r2), _mm512_set1_pd(acklamA[k]));
+                    pb = _mm512_add_pd(_mm512_mul_pd(pb, r2), _mm512_set1_pd(acklamB[k]));
+                }
+                __m512d y = _mm512_div_pd(_mm512_mul_pd(pa, r), pb);
+                __mmask8 tails = _mm512_cmp_pd_mask(x, low, _CMP_LT_OQ) | _mm512_cmp_pd_mask(x, high, _CMP_GT_OQ);
+                // Queues calculées seulement si une voie y tombe
+                if (tails) {
+                    __m512d t = _mm512_sqrt_pd(_mm512_mul_pd(_mm512_set1_pd(-2.0),
+                        logAVX512(_mm512_min_pd(x, _mm512_sub_pd(one, x)))));
+                    __m512d pc = _mm512_set1_pd(acklamC[0]), pd = _mm512_set1_pd(acklamD[0]);
+                    for (int k = 1; k < 6; ++k)
+                        pc = _mm512_add_pd(_mm512_mul_pd(pc, t), _mm512_set1_pd(acklamC[k]));
+                    for (int k = 1; k < 5; ++k)
+                        pd = _mm512_add_pd(_mm512_mul_pd(pd, t), _mm512_set1_pd(acklamD[k]));
+                    __m512d tail = _mm512_div_pd(pc, pd);
+                    __mmask8 upper = _mm512_cmp_pd_mask(x, half, _CMP_GT_OQ);
+                    tail = _mm512_mask_sub_pd(tail, upper, _mm512_setzero_pd(), tail);
+                    y = _mm512_mask_blend_pd(tails, y, tail);
+                }
+                _mm512_storeu_pd(z + i, y);
+            }
+            _mm256_zeroupper();
+            inverseNormalScalar(u + i, z + i, n - i);
+        }
+
+#endif // CRR_SIMD_X86
+
+        //=====================================================================
+        // Sélection à l'exécution
+        //=====================================================================
+
+        struct Table {
+            Isa isa;
+            void (*rollback)(double*, int, double, double);
+            void (*rollbackMax)(double*, const double*, int, double, double);
+            void (*step)(const double*, double*, int, double, double);
+            void (*stepMax)(const double*, const double*, double*, int, double, double);
+            void (*call)(const double*, double, double*, int);
+            void (*put)(const double*, double, double*, int);
+            double (*dot)(const double*, const double*, int);
+            void (*rollback3)(double*, int, double, double, double);
+            void (*rollbackMax3)(double*, const double*, int, double, double, double);
+            void (*step3)(const double*, double*, int, double, double, double);
+            void (*stepMax3)(const double*, const double*, double*, int, double, double, double);
+            void (*rollbackStrided)(double*, int, int, double, double);
+            void (*rollbackMaxStrikes)(double*, const double*, const double*, int, int, double, double, bool);
+            void (*normalPairs)(std::uint64_t, std::uint64_t, std::uint32_t, double*, double*, int);
+            void (*gbmStep)(const double*, const double*, double*, int, double, double);
+            void (*inverseNormal)(const double*, double*, int);
+        };
+
+        const Table scalarTable = { Isa::Scalar, rollbackScalar, rollbackMaxScalar, stepScalar,
+            stepMaxScalar, callScalar, putScalar, dotScalar,
+            rollback3Scalar, rollbackMax3Scalar, step3Scalar, stepMax3Scalar,
+            rollbackStridedScalar, rollbackMaxStrikesScalar, normalPairsScalar, gbmStepScalar,
+            inverseNormalScalar };
+#ifdef CRR_SIMD_X86
+        const Table sse2Table = { Isa::SSE2, rollbackSSE2, rollbackMaxSSE2, stepSSE2,
+            stepMaxSSE2, callSSE2, putSSE2, dotSSE2,
+            rollback3SSE2, rollbackMax3SSE2, step3SSE2, stepMax3SSE2,
+            rollbackStridedSSE2, rollbackMaxStrikesSSE2, normalPairsScalar, gbmStepScalar,
+            inverseNormalScalar };
+        const Table avx2Table = { Isa::AVX2, rollbackAVX2, rollbackMaxAVX2, stepAVX2,
+            stepMaxAVX2, callAVX2, putAVX2, dotAVX2,
+            rollback3AVX2, rollbackMax3AVX2, step3AVX2, stepMax3AVX2,
+            rollbackStridedAVX2, rollbackMaxStrikesAVX2, normalPairsAVX2, gbmStepAVX2,
+            inverseNormalAVX2 };
+        const Table avx512Table = { Isa::AVX512, rollbackAVX512, rollbackMaxAVX512, stepAVX512,
+            stepMaxAVX512, callAVX512, putAVX512, dotAVX512,
+            rollback3AVX512, rollbackMax3AVX512, step3AVX512, stepMax3AVX512,
+            rollbackStridedAVX512, rollbackMaxStrikesAVX512, normalPairsAVX512, gbmStepAVX512,
+            inverseNormalAVX512 };
+#endif
+
+        const Table* tableFor(Isa isa) {
+            switch (isa) {
+#ifdef CRR_SIMD_X86
+            case Isa::AVX512: return &avx512Table;
+            case Isa::AVX2:   return &avx2Table;
+            case Isa::SSE2:   return &sse2Table;
+#endif
+            default:          return &scalarTable;
+            }
+        }
+
+        Isa detect() {
+#ifdef CRR_SIMD_X86
+#ifdef _MSC_VER
+            int info[4];
+            __cpuid(info, 0);
+            int maxLeaf = info[0];
+            __cpuid(info, 1);
+            bool sse2 = (info[3] & (1 << 26)) != 0;
+            bool osxsave = (info[2] & (1 << 27)) != 0;
+            bool avx = (info[2] & (1 << 28)) != 0;
+            unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+            bool ymm = (xcr0 & 0x6) == 0x6;
+            bool zmm = (xcr0 & 0xE6) == 0xE6;
+            bool avx2 = false, avx512 = false;
+            if (maxLeaf >= 7) {
+                __cpuidex(info, 7, 0);
+                avx2 = (info[1] & (1 << 5)) != 0;
+                avx512 = (info[1] & (1 << 16)) != 0;
+            }
+            if (avx512 && avx && zmm) return Isa::AVX512;
+            if (avx2 && avx && ymm)   return Isa::AVX2;
+            if (sse2)                 return Isa::SSE2;
+#else
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) return Isa::AVX512;
+            if (__builtin_cpu_supports("avx2"))    return Isa::AVX2;
+            if (__builtin_cpu_supports("sse2"))    return Isa::SSE2;
+#endif
+#endif
+            return Isa::Scalar;
+        }
+
+        std::atomic<const Table*>& current() {
+            static std::atomic<const Table*> table(tableFor(detectedIsa()));
+            return table;
+        }
+
+        const Table& active() {
+            return *current().load(std::memory_order_relaxed);
+        }
+
+    } // namespace
+
+    Isa detectedIsa() {
+        static const Isa isa = detect();
+        return isa;
+    }
+
+    Isa activeIsa() {
+        return active().isa;
+    }
+
+    Isa setIsa(Isa isa) {
+        Isa chosen = std::min<Isa>(isa, detectedIsa());
+        current().store(tableFor(chosen), std::memory_order_relaxed);
+        return chosen;
+    }
+
+    void rollback(double* V, int n, double pu, double pd) {
+        active().rollback(V, n, pu, pd);
+    }
+
+    void rollbackMax(double* V, const double* E, int n, double pu, double pd) {
+        active().rollbackMax(V, E, n, pu, pd);
+    }
+
+    void step(const double* next, double* cur, int n, double pu, double pd) {
+        active().step(next, cur, n, pu, pd);
+    }
+
+    void stepMax(const double* next, const double* E, double* cur, int n, double pu, double pd) {
+        active().stepMax(next, E, cur, n, pu, pd);
+    }
+
+    void callValues(const double* S, double K, double* out, int n) {
+        active().call(S, K, out, n);
+    }
+
+    void putValues(const double* S, double K, double* out, int n) {
+        active().put(S, K, out, n);
+    }
+
+    double dot(const double* a, const double* b, int n) {
+        return active().dot(a, b, n);
+    }
+
+    void rollback3(double* V, int n, double pu, double pm, double pd) {
+        active().rollback3(V, n, pu, pm, pd);
+    }
+
+    void rollbackMax3(double* V, const double* E, int n, double pu, double pm, double pd) {
+        active().rollbackMax3(V, E, n, pu, pm, pd);
+    }
+
+    void step3(const double* next, double* cur, int n, double pu, double pm, double pd) {
+        active().step3(next, cur, n, pu, pm, pd);
+    }
+
+    void stepMax3(const double* next, const double* E, double* cur, int n, double pu, double pm, double pd) {
+        active().stepMax3(next, E, cur, n, pu, pm, pd);
+    }
+
+    void rollbackStrided(double* V, int n, int stride, double pu, double pd) {
+        active().rollbackStrided(V, n, stride, pu, pd);
+    }
+
+    void rollbackMaxStrikes(double* V, const double* S, const double* K, int M, int n, double pu, double pd, bool put) {
+        active().rollbackMaxStrikes(V, S, K, M, n, pu, pd, put);
+    }
+
+    void normalPairs(std::uint64_t seed, std::uint64_t path0, std::uint32_t pair, double* z0, double* z1, int n) {
+        active().normalPairs(seed, path0, pair, z0, z1, n);
+    }
+
+    void gbmStep(const double* S, const double* Z, double* next, int n, double drift, double vol) {
+        active().gbmStep(S, Z, next, n, drift, vol);
+    }
+
+    void inverseNormal(const double* u, double* z, int n) {
+        active().inverseNormal(u, z, n);
+    }
+
+} // namespace simd
+} // namespace crr
@@ -0,0 +1,138 @@
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include <cstdint>
+
+namespace crr {
+namespace simd {
+
+    /**
+     * @brief Jeux d’instructions vectorielles disponibles pour les noyaux.
+     */
+    enum class Isa {
+        Scalar,  ///< Boucles C++ sans intrinsèques.
+        SSE2,    ///< 2 doubles par registre.
+        AVX2,    ///< 4 doubles par registre.
+        AVX512   ///< 8 doubles par registre.
+    };
+
+    /**
+     * @brief Meilleur jeu d’instructions supporté par le processeur (détecté une seule fois).
+     */
+    Isa detectedIsa();
+
+    /**
+     * @brief Jeu d’instructions utilisé par les noyaux.
+     */
+    Isa activeIsa();
+
+    /**
+     * @brief Impose un jeu d’instructions (borné par celui détecté), par exemple pour comparer les chemins.
+     * @return Jeu d’instructions effectivement retenu.
+     */
+    Isa setIsa(Isa isa);
+
+    /**
+     * @brief Pas de rétropropagation en place : V[i] = pu V[i + 1] + pd V[i], i = 0..n-1.
+     * @details Les lectures précèdent toujours les écritures dans l’ordre croissant, ce qui
+     *          permet la mise à jour vectorielle en place. Tous les chemins calculent la même
+     *          expression (sans FMA) : les résultats sont identiques au bit près.
+     */
+    void rollback(double* V, int n, double pu, double pd);
+
+    /**
+     * @brief Pas de rétropropagation en place avec exercice anticipé :
+     *        V[i] = max(E[i], pu V[i + 1] + pd V[i]), i = 0..n-1.
+     */
+    void rollbackMax(double* V, const double* E, int n, double pu, double pd);
+
+    /**
+     * @brief Pas de rétropropagation hors place : cur[i] = pu next[i + 1] + pd next[i].
+     */
+    void step(const double* next, double* cur, int n, double pu, double pd);
+
+    /**
+     * @brief Pas hors place avec exercice : cur[i] = max(E[i], pu next[i + 1] + pd next[i]).
+     */
+    void stepMax(const double* next, const double* E, double* cur, int n, double pu, double pd);
+
+    /**
+     * @brief Payoff call sur un tableau : out[i] = max(S[i] - K, 0).
+     */
+    void callValues(const double* S, double K, double* out, int n);
+
+    /**
+     * @brief Payoff put sur un tableau : out[i] = max(K - S[i], 0).
+     */
+    void putValues(const double* S, double K, double* out, int n);
+
+    /**
+     * @brief Produit scalaire sum_i a[i] b[i].
+     * @details Réduction en blocs de 8 accumulateurs, identique pour tous les jeux d’instructions.
+     */
+    double dot(const double* a, const double* b, int n);
+
+    /**
+     * @brief Pas trinomial en place : V[i] = pu V[i + 2] + pm V[i + 1] + pd V[i], i = 0..n-1.
+     * @details Même ordre de lecture que rollback() : la mise à jour en place reste valide.
+     */
+    void rollback3(double* V, int n, double pu, double pm, double pd);
+
+    /**
+     * @brief Pas trinomial en place avec exercice : V[i] = max(E[i], pu V[i + 2] + pm V[i + 1] + pd V[i]).
+     */
+    void rollbackMax3(double* V, const double* E, int n, double pu, double pm, double pd);
+
+    /**
+     * @brief Pas trinomial hors place : cur[i] = pu next[i + 2] + pm next[i + 1] + pd next[i].
+     */
+    void step3(const double* next, double* cur, int n, double pu, double pm, double pd);
+
+    /**
+     * @brief Pas trinomial hors place avec exercice : cur[i] = max(E[i], pu next[i + 2] + pm next[i + 1] + pd next[i]).
+     */
+    void stepMax3(const double* next, const double* E, double* cur, int n, double pu, double pm, double pd);
+
+    /**
+     * @brief Pas en place sur des lignes de stride valeurs : V[j] = pu V[j + stride] + pd V[j], j = 0..n-1.
+     * @details Rétropropagation de plusieurs options entrelacées (nœud i, option m en i stride + m).
+     */
+    void rollbackStrided(double* V, int n, int stride, double pu, double pd);
+
+    /**
+     * @brief Pas en place avec exercice sur M strikes entrelacés, pour les lignes i = 0..n-1 :
+     *        V[i M + m] = max(E, pu V[(i + 1) M + m] + pd V[i M + m]),
+     *        E = max(K[m] - S[i], 0) pour un put, max(S[i] - K[m], 0) pour un call.
+     * @details Vectorisé sur les strikes : mêmes valeurs que rollbackMax() option par option.
+     */
+    void rollbackMaxStrikes(double* V, const double* S, const double* K, int M, int n, double pu, double pd, bool put);
+
+    /**
+     * @brief Deux normales par trajectoire, pour les trajectoires path0..path0 + n - 1 :
+     *        z0[i], z1[i] = tirages 2 pair et 2 pair + 1 de la trajectoire path0 + i.
+     * @details Philox4x32-10 (voir philox4x32) de clé seed au compteur (pair, path0 + i) donne
+     *          deux uniformes de 52 bits dans ]0, 1[, puis Box-Muller deux normales. Le logarithme,
+     *          le sinus et le cosinus sont polynomiaux (erreur de l’ordre de l’ulp), sans FMA :
+     *          les résultats sont identiques au bit près pour tous les jeux d’instructions, la
+     *          trajectoire i étant calculée dans une voie vectorielle (SSE2 : chemin scalaire).
+     */
+    void normalPairs(std::uint64_t seed, std::uint64_t path0, std::uint32_t pair, double* z0, double* z1, int n);
+
+    /**
+     * @brief Pas du brownien géométrique : next[i] = S[i] exp(drift + vol Z[i]).
+     * @details Exponentielle polynomiale, identique pour tous les jeux d’instructions.
+     */
+    void gbmStep(const double* S, const double* Z, double* next, int n, double drift, double vol);
+
+    /**
+     * @brief Inverse de la fonction de répartition normale : z[i] = Φ^-1(u[i]), u[i] dans ]0, 1[.
+     * @details Approximation rationnelle d’Acklam (erreur relative inférieure à 1.15e-9), dont les
+     *          queues utilisent le logarithme polynomial de normalPairs : identique pour tous les
+     *          jeux d’instructions. u et z peuvent être confondus.
+     */
+    void inverseNormal(const double* u, double* z, int n);
+
+} // namespace simd
+} // namespace crr
+
+#endif // KERNELS_H
@@ -0,0 +1,48 @@
+#include "pch.h"
+#include "Lattice.h"
+#include <cstdlib>
+#include <stdexcept>
+
+#ifdef _MSC_VER
+#include <malloc.h>  // _aligned_malloc
+#endif
+
+namespace crr {
+
+    void* alignedMalloc(std::size_t bytes, std::size_t align) {
+        if (bytes == 0)
+            bytes = align;
+#ifdef _MSC_VER
+        return _aligned_malloc(bytes, align);
+#else
+        // aligned_alloc exige une taille multiple de l'alignement
+        bytes = (bytes + align - 1) / align * align;
+        return std::aligned_alloc(align, bytes);
+#endif
+    }
+
+    void alignedFree(void* p) {
+#ifdef _MSC_VER
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+
+    TriangularLattice::TriangularLattice(int levels)
+        : levels_(levels)
+    {
+        if (levels_ < 0)
+            throw std::invalid_argument("Nombre de niveaux doit être >= 0");
+        data_.resize(offset(levels_));
+    }
+
+    TrinomialLattice::TrinomialLattice(int levels)
+        : levels_(levels)
+    {
+        if (levels_ < 0)
+            throw std::invalid_argument("Nombre de niveaux doit être >= 0");
+        data_.resize(offset(levels_));
+    }
+
+} // namespace crr
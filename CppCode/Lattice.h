@@ -0,0 +1,172 @@
+#ifndef LATTICE_H
+#define LATTICE_H
+
+#include <vector>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace crr {
+
+    /**
+     * @brief Allocation alignée sur une ligne de cache (utilisable par std::vector).
+     * @tparam T Type des éléments.
+     * @tparam Align Alignement en octets.
+     */
+    template<typename T, std::size_t Align = 64>
+    class AlignedAllocator {
+    public:
+        using value_type = T;
+
+        template<typename U>
+        struct rebind { using other = AlignedAllocator<U, Align>; };
+
+        AlignedAllocator() = default;
+
+        template<typename U>
+        AlignedAllocator(const AlignedAllocator<U, Align>&) {}
+
+        T* allocate(std::size_t n);
+        void deallocate(T* p, std::size_t);
+
+        /**
+         * @brief Construction par défaut sans mise à zéro : les tampons sont toujours
+         *        entièrement écrits avant d’être lus.
+         */
+        template<typename U>
+        void construct(U* p) { ::new (static_cast<void*>(p)) U; }
+
+        template<typename U, typename... Args>
+        void construct(U* p, Args&&... args) { ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...); }
+
+        bool operator==(const AlignedAllocator&) const { return true; }
+        bool operator!=(const AlignedAllocator&) const { return false; }
+    };
+
+    /**
+     * @brief Allocation / libération alignées (implémentées selon la plateforme).
+     */
+    void* alignedMalloc(std::size_t bytes, std::size_t align);
+    void alignedFree(void* p);
+
+    template<typename T, std::size_t Align>
+    T* AlignedAllocator<T, Align>::allocate(std::size_t n) {
+        void* p = alignedMalloc(n * sizeof(T), Align);
+        if (!p)
+            throw std::bad_alloc();
+        return static_cast<T*>(p);
+    }
+
+    template<typename T, std::size_t Align>
+    void AlignedAllocator<T, Align>::deallocate(T* p, std::size_t) {
+        alignedFree(p);
+    }
+
+    /**
+     * @brief Vecteur de doubles alignés.
+     */
+    using AlignedVector = std::vector<double, AlignedAllocator<double>>;
+
+    /**
+     * @brief Vue sur un niveau du treillis.
+     */
+    template<typename TValue>
+    class LatticeRow {
+    private:
+        TValue* data_;
+        int size_;
+
+    public:
+        LatticeRow(TValue* data, int size) : data_(data), size_(size) {}
+
+        int size() const { return size_; }
+        TValue* data() const { return data_; }
+        TValue* begin() const { return data_; }
+        TValue* end() const { return data_ + size_; }
+        TValue& operator[](int i) const { return data_[i]; }
+    };
+
+    /**
+     * @brief Treillis triangulaire stocké dans un bloc contigu et aligné.
+     * @details Le niveau n contient n + 1 valeurs, rangées à la suite du niveau n - 1 :
+     *          la valeur (n, i) se trouve à la position n(n + 1)/2 + i.
+     */
+    class TriangularLattice {
+    public:
+        using Row = LatticeRow<double>;
+        using ConstRow = LatticeRow<const double>;
+
+        TriangularLattice() : levels_(0) {}
+
+        /**
+         * @param levels Nombre de niveaux (N + 1 pour un arbre à N pas).
+         */
+        explicit TriangularLattice(int levels);
+
+        /**
+         * @brief Nombre de niveaux.
+         */
+        int size() const { return levels_; }
+        bool empty() const { return levels_ == 0; }
+
+        /**
+         * @brief Position du premier élément du niveau n dans le bloc.
+         */
+        static std::size_t offset(int n) { return std::size_t(n) * (n + 1) / 2; }
+
+        double& operator()(int n, int i) { return data_[offset(n) + i]; }
+        double operator()(int n, int i) const { return data_[offset(n) + i]; }
+
+        Row operator[](int n) { return Row(data_.data() + offset(n), n + 1); }
+        ConstRow operator[](int n) const { return ConstRow(data_.data() + offset(n), n + 1); }
+
+        double* data() { return data_.data(); }
+        const double* data() const { return data_.data(); }
+
+    private:
+        int levels_;
+        AlignedVector data_;
+    };
+
+    /**
+     * @brief Treillis trinomial stocké dans un bloc contigu et aligné.
+     * @details Le niveau n contient 2n + 1 valeurs (nœud j : j - n pas nets à la hausse), rangées
+     *          à la suite du niveau n - 1 : la valeur (n, j) se trouve à la position n² + j.
+     */
+    class TrinomialLattice {
+    public:
+        using Row = LatticeRow<double>;
+        using ConstRow = LatticeRow<const double>;
+
+        TrinomialLattice() : levels_(0) {}
+
+        /**
+         * @param levels Nombre de niveaux (N + 1 pour un arbre à N pas).
+         */
+        explicit TrinomialLattice(int levels);
+
+        int size() const { return levels_; }
+        bool empty() const { return levels_ == 0; }
+
+        /**
+         * @brief Position du premier élément du niveau n dans le bloc.
+         */
+        static std::size_t offset(int n) { return std::size_t(n) * n; }
+
+        double& operator()(int n, int j) { return data_[offset(n) + j]; }
+        double operator()(int n, int j) const { return data_[offset(n) + j]; }
+
+        Row operator[](int n) { return Row(data_.data() + offset(n), 2 * n + 1); }
+        ConstRow operator[](int n) const { return ConstRow(data_.data() + offset(n), 2 * n + 1); }
+
+        double* data() { return data_.data(); }
+        const double* data() const { return data_.data(); }
+
+    private:
+        int levels_;
+        AlignedVector data_;
+    };
+
+} // namespace crr
+
+#endif // LATTICE_H
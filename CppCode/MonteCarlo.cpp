@@ -0,0 +1,174 @@
+#include "pch.h"
+#include "MonteCarlo.h"
+#include "Kernels.h"
+#include "Sobol.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace crr {
+
+    MonteCarlo::MonteCarlo(double S0, double R, double sigma, double T, const Settings& settings)
+        : S0_(S0), R_(R), sigma_(sigma), T_(T), settings_(settings)
+    {
+        if (settings_.mcSteps < 1)
+            throw std::invalid_argument("Le nombre de pas Monte Carlo doit être >= 1");
+        if (settings_.mcPaths < 1)
+            throw std::invalid_argument("Le nombre de trajectoires Monte Carlo doit être >= 1");
+        if (settings_.mcSampling == Sampling::Sobol
+            && (settings_.mcReplicates < 1 || settings_.mcPaths < settings_.mcReplicates))
+            throw std::invalid_argument("Le nombre de répétitions de Sobol doit être entre 1 et le nombre de trajectoires");
+        if (settings_.mcSampling == Sampling::Sobol && settings_.mcSteps > Sobol::maxDimensions)
+            throw std::invalid_argument("Le mode Sobol est limité à 481 pas Monte Carlo");
+        if (settings_.mcSampling == Sampling::Sobol)
+            settings_.mcPaths = sobolPaths(settings_.mcPaths, settings_.mcReplicates);
+    }
+
+    int MonteCarlo::sobolPaths(int paths, int replicates) {
+        int points = 1;
+        while (points <= paths / replicates / 2)
+            points *= 2;
+        return replicates * points;
+    }
+
+    MonteCarlo::Estimate MonteCarlo::estimate(const BlockPayoff& payoff) const {
+        return settings_.mcSampling == Sampling::Sobol ? sobol(payoff) : pseudoRandom(payoff);
+    }
+
+    MonteCarlo::Estimate MonteCarlo::pseudoRandom(const BlockPayoff& payoff) const {
+        int steps = settings_.mcSteps, paths = settings_.mcPaths;
+        int blocks = (paths + blockSize - 1) / blockSize;
+        double dt = T_ / steps;
+        double drift = (R_ - 0.5 * sigma_ * sigma_) * dt, vol = sigma_ * std::sqrt(dt);
+
+        std::vector<double> sums(blocks), squares(blocks);
+        auto block = [&](int b) {
+            int p0 = b * blockSize;
+            int count = std::min<int>(blockSize, paths - p0);
+            std::vector<double> S(std::size_t(steps + 1) * count), Z0(count), Z1(count), out(count);
+            std::fill(S.begin(), S.begin() + count, S0_);
+            for (int j = 0; j < steps; j += 2) {
+                simd::normalPairs(settings_.mcSeed, std::uint64_t(p0), std::uint32_t(j / 2), Z0.data(), Z1.data(), count);
+                double* row = S.data() + std::size_t(j) * count;
+                simd::gbmStep(row, Z0.data(), row + count, count, drift, vol);
+                if (j + 1 < steps)
+                    simd::gbmStep(row + count, Z1.data(), row + 2 * count, count, drift, vol);
+            }
+            payoff(S.data(), count, out.data());
+            double sum = 0.0, square = 0.0;
+            for (int p = 0; p < count; ++p) {
+                sum += out[p];
+                square += out[p] * out[p];
+            }
+            sums[b] = sum;
+            squares[b] = square;
+        };
+        parallelFor(threadCount(settings_.threads), blocks, block);
+
+        double total = 0.0, totalSquare = 0.0;
+        for (int b = 0; b < blocks; ++b) {
+            total += sums[b];
+            totalSquare += squares[b];
+        }
+        double discount = std::exp(-R_ * T_);
+        double mean = total / paths;
+        double variance = paths > 1 ? std::max(0.0, (totalSquare - paths * mean * mean) / (paths - 1)) : 0.0;
+        return { discount * total / paths, discount * std::sqrt(variance / paths) };
+    }
+
+    std::vector<MonteCarlo::BridgeStep> MonteCarlo::bridge() const {
+        // Intervalles coupés en leur milieu en largeur d'abord : les grandes échelles d'abord
+        int steps = settings_.mcSteps;
+        double dt = T_ / steps;
+        std::vector<BridgeStep> order;
+        std::vector<std::pair<int, int>> intervals(1, std::make_pair(0, steps));
+        for (std::size_t k = 0; k < intervals.size(); ++k) {
+            int l = intervals[k].first, r = intervals[k].second;
+            if (r - l < 2)
+                continue;
+            int m = (l + r) / 2;
+            double tl = l * dt, tm = m * dt, tr = r * dt;
+            order.push_back({ l, m, r, (tr - tm) / (tr - tl), (tm - tl) / (tr - tl),
+                std::sqrt((tm - tl) * (tr - tm) / (tr - tl)) });
+            intervals.push_back(std::make_pair(l, m));
+            intervals.push_back(std::make_pair(m, r));
+        }
+        return order;
+    }
+
+    MonteCarlo::Estimate MonteCarlo::sobol(const BlockPayoff& payoff) const {
+        int steps = settings_.mcSteps, replicates = settings_.mcReplicates;
+        int points = settings_.mcPaths / replicates;  // puissance de deux (constructeur)
+        int blocks = (points + blockSize - 1) / blockSize;
+        double dt = T_ / steps;
+        double drift = (R_ - 0.5 * sigma_ * sigma_) * dt, vol = sigma_ * std::sqrt(dt);
+        std::vector<BridgeStep> order = bridge();
+
+        Sobol base(steps);
+        std::vector<Sobol> sequences;
+        for (int r = 0; r < replicates; ++r)
+            sequences.push_back(base.scrambled(settings_.mcSeed ^ (std::uint64_t(r) * 0xD1B54A32D192ED03ull)));
+
+        std::vector<double> sums(std::size_t(replicates) * blocks);
+        auto block = [&](int w) {
+            int r = w / blocks, p0 = (w % blocks) * blockSize;
+            int count = std::min<int>(blockSize, points - p0);
+            std::vector<double> Z(std::size_t(steps) * count), S(std::size_t(steps + 1) * count);
+            std::vector<double> previous(count, 0.0), dZ(count), out(count);
+            sequences[r].points(std::uint32_t(p0), count, Z.data());
+            simd::inverseNormal(Z.data(), Z.data(), steps * count);
+
+            // Pont brownien dans S (W(0) = 0) : W(T) avec la première coordonnée, puis les milieux
+            double* WT = S.data() + std::size_t(steps) * count;
+            for (int p = 0; p < count; ++p)
+                WT[p] = std::sqrt(T_) * Z[p];
+            for (std::size_t k = 0; k < order.size(); ++k) {
+                const BridgeStep& o = order[k];
+                const double* z = Z.data() + (k + 1) * count;
+                const double* Wl = S.data() + std::size_t(o.left) * count;
+                const double* Wr = S.data() + std::size_t(o.right) * count;
+                double* Wm = S.data() + std::size_t(o.mid) * count;
+                for (int p = 0; p < count; ++p)
+                    Wm[p] = o.wl * Wl[p] + o.wr * Wr[p] + o.sd * z[p];
+            }
+
+            // Accroissements ramenés à des normales centrées réduites, puis pas log-normaux en place
+            std::fill(S.begin(), S.begin() + count, S0_);
+            double scale = 1.0 / std::sqrt(dt);
+            for (int j = 0; j < steps; ++j) {
+                double* row = S.data() + std::size_t(j) * count;
+                double* W = row + count;
+                for (int p = 0; p < count; ++p) {
+                    dZ[p] = (W[p] - previous[p]) * scale;
+                    previous[p] = W[p];
+                }
+                simd::gbmStep(row, dZ.data(), W, count, drift, vol);
+            }
+            payoff(S.data(), count, out.data());
+            double sum = 0.0;
+            for (int p = 0; p < count; ++p)
+                sum += out[p];
+            sums[w] = sum;
+        };
+        parallelFor(threadCount(settings_.threads), replicates * blocks, block);
+
+        double discount = std::exp(-R_ * T_);
+        double total = 0.0, totalSquare = 0.0;
+        for (int r = 0; r < replicates; ++r) {
+            double sum = 0.0;
+            for (int b = 0; b < blocks; ++b)
+                sum += sums[std::size_t(r) * blocks + b];
+            double value = discount * sum / points;
+            total += value;
+            totalSquare += value * value;
+        }
+        double mean = total / replicates;
+        double variance = replicates > 1
+            ? std::max(0.0, (totalSquare - replicates * mean * mean) / (replicates - 1)) : 0.0;
+        return { mean, std::sqrt(variance / replicates) };
+    }
+
+} // namespace crr
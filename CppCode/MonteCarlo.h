@@ -0,0 +1,131 @@
+#ifndef MONTECARLO_H
+#define MONTECARLO_H
+
+#include "Settings.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace crr {
+
+    /**
+     * @brief Générateur à compteur Philox4x32-10 (Salmon, Moraes, Dror, Shaw, 2011).
+     * @details Dix tours de multiplications 32 x 32 -> 64 bits mélangent le compteur sous la
+     *          clé : chaque (compteur, clé) donne quatre mots indépendants, sans état à faire
+     *          avancer. Un tirage se retrouve donc directement à partir de sa position.
+     * @param counter Compteur (quatre mots).
+     * @param key     Clé (deux mots).
+     * @param out     Quatre mots aléatoires.
+     */
+    inline void philox4x32(const std::uint32_t counter[4], const std::uint32_t key[2], std::uint32_t out[4]) {
+        const std::uint32_t M0 = 0xD2511F53u, M1 = 0xCD9E8D57u;
+        const std::uint32_t W0 = 0x9E3779B9u, W1 = 0xBB67AE85u;
+        std::uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+        std::uint32_t k0 = key[0], k1 = key[1];
+        for (int round = 0; round < 10; ++round) {
+            std::uint64_t p0 = std::uint64_t(M0) * c0, p1 = std::uint64_t(M1) * c2;
+            std::uint32_t hi0 = std::uint32_t(p0 >> 32), lo0 = std::uint32_t(p0);
+            std::uint32_t hi1 = std::uint32_t(p1 >> 32), lo1 = std::uint32_t(p1);
+            c0 = hi1 ^ c1 ^ k0;
+            c1 = lo1;
+            c2 = hi0 ^ c3 ^ k1;
+            c3 = lo0;
+            k0 += W0;
+            k1 += W1;
+        }
+        out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+    }
+
+    /**
+     * @brief Simulation Monte Carlo de trajectoires du sous-jacent sous la probabilité risque-neutre.
+     * @details Le sous-jacent suit un mouvement brownien géométrique discrétisé exactement sur
+     *          Settings::mcSteps pas. Les Settings::mcPaths trajectoires sont simulées par blocs
+     *          de blockSize, répartis entre Settings::threads threads (parallelFor). Dans un bloc,
+     *          les trajectoires avancent ensemble pas à pas, stockées par pas (structure de
+     *          tableaux) : deux pas à la fois, simd::normalPairs tire les normales de toutes les
+     *          trajectoires et simd::gbmStep fait avancer leurs prix. Les tirages 2k et 2k + 1 de
+     *          la trajectoire p ne dépendent que de (Settings::mcSeed, p, k) et la somme des blocs
+     *          se fait dans leur ordre : le résultat est identique au bit près quel que soit le
+     *          nombre de threads ou le jeu d’instructions.
+     *
+     *          En mode Sampling::Sobol, les trajectoires forment Settings::mcReplicates répétitions
+     *          de 2^m points d’une suite de Sobol à mcSteps dimensions, brouillée indépendamment
+     *          pour chaque répétition : 2^m est la plus grande puissance de deux n’excédant pas
+     *          mcPaths / mcReplicates (voir sobolPaths()), seuls les blocs de 2^m points gardant
+     *          les propriétés d’équirépartition de la suite. Le pont
+     *          brownien construit W(T) avec la première coordonnée puis les milieux successifs, de
+     *          sorte que les premières dimensions, les mieux réparties, portent l’essentiel de la
+     *          variance. L’erreur type se lit sur la dispersion des répétitions.
+     */
+    class MonteCarlo {
+    public:
+        static const int blockSize = 256;  ///< Trajectoires par bloc
+
+        /**
+         * @brief Payoffs d’un bloc de trajectoires.
+         * @details S contient (steps + 1) lignes de count prix : S[j count + p] est le prix de la
+         *          trajectoire p après j pas (S0 en ligne 0). out reçoit les count payoffs, non
+         *          actualisés.
+         */
+        using BlockPayoff = std::function<void(const double* S, int count, double* out)>;
+
+        /**
+         * @brief Estimation Monte Carlo et son erreur type.
+         */
+        struct Estimate {
+            double value;  ///< Espérance actualisée estimée
+            double error;  ///< Erreur type de l’estimation
+        };
+
+    private:
+        double S0_, R_, sigma_, T_;
+        Settings settings_;
+
+        /**
+         * @brief Un milieu du pont brownien : W[mid] = wl W[left] + wr W[right] + sd Z.
+         */
+        struct BridgeStep {
+            int left, mid, right;
+            double wl, wr, sd;
+        };
+
+        std::vector<BridgeStep> bridge() const;
+        Estimate pseudoRandom(const BlockPayoff& payoff) const;
+        Estimate sobol(const BlockPayoff& payoff) const;
+
+    public:
+        /**
+         * @param settings Paramètres numériques (mcSteps, mcPaths, mcSeed, mcSampling,
+         *                 mcReplicates, threads).
+         */
+        MonteCarlo(double S0, double R, double sigma, double T, const Settings& settings = Settings());
+
+        /**
+         * @brief Nombre de trajectoires simulées en mode Sampling::Sobol.
+         * @return replicates 2^m, m le plus grand tel que replicates 2^m <= paths.
+         */
+        static int sobolPaths(int paths, int replicates);
+
+        int steps() const { return settings_.mcSteps; }
+
+        /**
+         * @brief Nombre de trajectoires effectivement simulées (arrondi par sobolPaths() en mode Sobol).
+         */
+        int paths() const { return settings_.mcPaths; }
+
+        /**
+         * @brief Espérance actualisée du payoff et son erreur type.
+         * @details Écart type empirique des payoffs sur √mcPaths en mode Sampling::PseudoRandom,
+         *          écart type des mcReplicates répétitions sur √mcReplicates en mode Sampling::Sobol.
+         */
+        Estimate estimate(const BlockPayoff& payoff) const;
+
+        /**
+         * @brief Espérance actualisée du payoff.
+         */
+        double price(const BlockPayoff& payoff) const { return estimate(payoff).value; }
+    };
+
+} // namespace crr
+
+#endif // MONTECARLO_H
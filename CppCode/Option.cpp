@@ -1,30 +1,114 @@
 #include "pch.h"
 #include "Option.h"
+#include <limits>
 
 namespace crr {
 
-    Option::Option(double S0, double R, double sigma, double T, int N)
-        : S0_(S0), R_(R), sigma_(sigma), T_(T), N_(N)
+    namespace {
+
+        /**
+         * @brief Inversion de Peizer-Pratt (méthode 2) : probabilité binomiale associée à z sur n pas.
+         */
+        double peizerPratt(double z, int n) {
+            double t = z / (n + 1.0 / 3.0 + 0.1 / (n + 1.0));
+            double r = 0.5 * std::sqrt(1.0 - std::exp(-t * t * (n + 1.0 / 6.0)));
+            return z > 0.0 ? 0.5 + r : 0.5 - r;
+        }
+
+    } // namespace
+
+    Option::Option(double S0, double R, double sigma, double T, int N, const Settings& settings, double strike)
+        : S0_(S0), R_(R), sigma_(sigma), T_(T), N_(N), settings_(settings)
     {
         if (S0_ < 0.0)    throw std::invalid_argument("S0 doit être >= 0");
         if (sigma_ < 0.0) throw std::invalid_argument("Sigma doit être >= 0");
         if (T_ < 0.0)     throw std::invalid_argument("T doit être >= 0");
         if (N_ <= 0)      throw std::invalid_argument("N doit être > 0");
+        // Leisen-Reimer ne converge régulièrement qu'avec un nombre de pas impair
+        if (settings_.parameterization == Parameterization::LeisenReimer && N_ % 2 == 0)
+            ++N_;
 
         double dt = T_ / N_;
         double sq = sigma_ * std::sqrt(dt);
         double rN = R_ * dt;
-        u_ = rN + sq;
-        d_ = rN - sq;
-        discount_ = 1.0 / (1.0 + rN);
-    }
+        double growth = std::exp(rN);  // facteur de capitalisation d'un pas (paramétrisations continues)
+        double up = 0.0, down = 0.0;   // facteurs U et D
+
+        switch (settings_.parameterization) {
+        case Parameterization::Classic:
+            u_ = rN + sq;
+            d_ = rN - sq;
+            discount_ = 1.0 / (1.0 + rN);
+            p_ = 0.5;
+            break;
+
+        case Parameterization::CoxRossRubinstein:
+            up = std::exp(sq);
+            down = 1.0 / up;
+            break;
 
-    double Option::price() const {
-        return treePrice()[0][0];
+        case Parameterization::JarrowRudd:
+            up = std::exp(rN - 0.5 * sq * sq + sq);
+            down = std::exp(rN - 0.5 * sq * sq - sq);
+            break;
+
+        case Parameterization::Tian: {
+            double v = std::exp(sq * sq);
+            double root = std::sqrt(v * v + 2.0 * v - 3.0);
+            up = 0.5 * growth * v * (v + 1.0 + root);
+            down = 0.5 * growth * v * (v + 1.0 - root);
+            break;
+        }
+
+        case Parameterization::LeisenReimer: {
+            double K = settings_.strike > 0.0 ? settings_.strike : (strike > 0.0 ? strike : S0_);
+            double volT = sigma_ * std::sqrt(T_);
+            double d1 = (std::log(S0_ / K) + (R_ + 0.5 * sigma_ * sigma_) * T_) / volT;
+            double d2 = d1 - volT;
+            double p = peizerPratt(d2, N_);
+            up = growth * peizerPratt(d1, N_) / p;
+            down = (growth - p * up) / (1.0 - p);
+            break;
+        }
+
+        default:
+            throw std::invalid_argument("Paramétrisation inconnue");
+        }
+
+        if (settings_.parameterization != Parameterization::Classic) {
+            u_ = up - 1.0;
+            d_ = down - 1.0;
+            discount_ = 1.0 / growth;
+            p_ = (growth - down) / (up - down);
+            if (!(p_ > 0.0 && p_ < 1.0))
+                throw std::invalid_argument("Probabilité risque-neutre hors de ]0, 1[ : augmenter N ou vérifier sigma et T");
+        }
+        pu_ = discount_ * p_;
+        pd_ = discount_ * (1.0 - p_);
     }
 
     double Option::deltaZero() const {
-        return hedgingStrategy().delta[0][0];
+        return greeks().delta;
+    }
+
+    Option::Greeks Option::greeksFromLevels(double V0, const double* V1, const double* V2) const {
+        Greeks g;
+        g.price = V0;
+        g.delta = (V1[1] - V1[0]) / (S0_ * (1 + u_) - S0_ * (1 + d_));
+        g.gamma = std::numeric_limits<double>::quiet_NaN();
+        g.theta = std::numeric_limits<double>::quiet_NaN();
+        if (V2) {
+            double Suu = S0_ * (1 + u_) * (1 + u_);
+            double Sud = S0_ * (1 + u_) * (1 + d_);
+            double Sdd = S0_ * (1 + d_) * (1 + d_);
+            double deltaUp = (V2[2] - V2[1]) / (Suu - Sud);
+            double deltaDown = (V2[1] - V2[0]) / (Sud - Sdd);
+            g.gamma = (deltaUp - deltaDown) / (0.5 * (Suu - Sdd));
+            // Le nœud (2, 1) n’est pas exactement en S0 : on retire la variation due au sous-jacent
+            double dS = Sud - S0_;
+            g.theta = (V2[1] - V0 - g.delta * dS - 0.5 * g.gamma * dS * dS) / (2.0 * T_ / N_);
+        }
+        return g;
     }
 
 } // namespace crr
@@ -1,9 +1,10 @@
 #ifndef OPTION_H
 #define OPTION_H
 
+#include "Lattice.h"
+#include "Settings.h"
 #include <vector>
 #include <cmath>
-#include <random>
 #include <stdexcept>
 
 namespace crr {
@@ -16,49 +17,102 @@ namespace crr {
         double S0_, R_, sigma_, T_;  ///< Paramètres initiaux
         int    N_;                   ///< Nombre de pas
         double u_, d_, discount_;    ///< Paramètres par pas
+        double p_;                   ///< Probabilité risque-neutre de hausse
+        double pu_, pd_;             ///< Probabilités risque-neutres actualisées (hausse, baisse)
+        Settings settings_;          ///< Paramètres numériques
 
     public:
         /**
-         * @brief Constructeur : initialise les paramètres de l’option pour le modèle CRR.
+         * @brief Constructeur : initialise les paramètres d’un pas selon Settings::parameterization.
          * @param S0    Prix initial du sous-jacent.
          * @param R     Taux d’intérêt sans risque continu.
          * @param sigma Volatilité annuelle du sous-jacent.
          * @param T     Durée jusqu’à l’échéance en années.
-         * @param N     Nombre de pas de l’arbre binomial.
+         * @param N     Nombre de pas de l’arbre binomial, arrondi à l’impair supérieur pour
+         *              Leisen-Reimer (voir steps()).
+         * @param settings Paramètres numériques des moteurs.
+         * @param strike   Strike du payoff, utilisé par Leisen-Reimer si Settings::strike vaut 0.
          */
-        Option(double S0, double R, double sigma, double T, int N);
+        Option(double S0, double R, double sigma, double T, int N, const Settings& settings = Settings(),
+            double strike = 0.0);
 
         /**
-         * @brief Arbre des prix de l’option selon le modèle CRR.
-         * @return Matrice des valeurs aux nœuds.
+         * @brief Nombre de pas effectif de l’arbre.
          */
-        virtual std::vector<std::vector<double>> treePrice() const = 0;
+        int steps() const { return N_; }
 
         /**
          * @brief Prix initial de l’option.
          * @return Valeur de l’option à n = 0.
          */
-        double price() const;
+        virtual double price() const = 0;
 
         /**
          * @brief Stratégie de couverture : delta et obligation.
+         * @details Chaque moteur expose treePrice() et hedgingStrategy() avec son propre
+         *          conteneur : TriangularLattice pour les arbres recombinants, matrice
+         *          niveau par niveau (2^n nœuds) pour les arbres non recombinants.
+         * @tparam TTree Type de l’arbre des positions.
          */
+        template<typename TTree>
         struct HedgingStrategy {
-            std::vector<std::vector<double>> delta;  ///< Positions en sous-jacent.
-            std::vector<std::vector<double>> bond;   ///< Positions en actif sans risque.
+            TTree delta;  ///< Positions en sous-jacent.
+            TTree bond;   ///< Positions en actif sans risque.
         };
 
         /**
-         * @brief Calcule la couverture optimale (CRR).
-         * @return HedgingStrategy contenant delta et bond par nœud.
+         * @brief Un niveau de la stratégie de couverture sur un arbre recombinant.
+         * @details Les pointeurs ne sont valides que pendant l’appel au visiteur qui le reçoit.
          */
-        virtual HedgingStrategy hedgingStrategy() const = 0;
+        struct HedgingLevel {
+            int n;                 ///< Niveau (0..N-1).
+            int size;              ///< Nombre de nœuds, n + 1.
+            const double* stock;   ///< Prix du sous-jacent aux nœuds (n, i).
+            const double* value;   ///< Valeur de l’option aux nœuds (n, i).
+            const double* delta;   ///< Positions en sous-jacent sur [n, n + 1].
+            const double* bond;    ///< Positions en actif sans risque sur [n, n + 1].
+        };
+
+        /**
+         * @brief Sensibilités lues sur les premiers niveaux de l’arbre.
+         */
+        struct Greeks {
+            double price;  ///< Valeur de l’option à n = 0.
+            double delta;  ///< dV/dS, différence finie sur le niveau 1.
+            double gamma;  ///< d²V/dS², différences finies sur le niveau 2 (NaN si N < 2).
+            double theta;  ///< dV/dt par an, entre (0, 0) et (2, 1) à sous-jacent fixé (NaN si N < 2).
+        };
+
+        /**
+         * @brief Prix, delta, gamma et theta en une seule rétropropagation.
+         * @details Les niveaux 0 à 2 sont relevés au passage : le coût est celui de price(),
+         *          sans arbre des valeurs ni matrices de couverture.
+         */
+        virtual Greeks greeks() const = 0;
 
         /**
          * @brief Delta initial.
-         * @return Valeur du delta à n = 0.
+         * @return Valeur du delta à n = 0, soit greeks().delta.
+         */
+        virtual double deltaZero() const;
+
+    protected:
+        /**
+         * @brief Le niveau N - 1 est-il remplacé par Black-Scholes (Settings::smoothing) ?
+         * @details Jamais avec Leisen-Reimer : u, d et p sont ajustés à la loi terminale sur N pas,
+         *          que le lissage fausse (erreur multipliée par 360 à N = 101).
+         */
+        bool smoothsLastStep() const {
+            return settings_.smoothing != Smoothing::None && settings_.parameterization != Parameterization::LeisenReimer;
+        }
+
+        /**
+         * @brief Assemble les sensibilités à partir des valeurs des niveaux 0 à 2.
+         * @param V0 Valeur au nœud (0, 0).
+         * @param V1 Valeurs aux nœuds (1, 0) et (1, 1).
+         * @param V2 Valeurs aux nœuds (2, 0) à (2, 2), ou nullptr si N < 2.
          */
-        double deltaZero() const;
+        Greeks greeksFromLevels(double V0, const double* V1, const double* V2) const;
     };
 
 } // namespace crr
@@ -1,8 +1,74 @@
 #include "pch.h"
 #include "Payoff.h"
+#include "Kernels.h"
+#include <cmath>
 
 namespace opt {
 
+    namespace {
+
+        double normCdf(double x) {
+            return 0.5 * std::erfc(-x / std::sqrt(2.0));
+        }
+
+        /**
+         * @brief d1 et d2 de Black-Scholes ; volatilité ou durée nulle : signe de la moneyness forward.
+         */
+        void bsD(double S, double K, double r, double sigma, double tau, double& d1, double& d2) {
+            double volT = sigma * std::sqrt(tau);
+            double m = std::log(S / K) + r * tau;
+            if (volT <= 0.0) {
+                d1 = d2 = (m > 0.0 ? HUGE_VAL : -HUGE_VAL);
+                return;
+            }
+            d1 = (m + 0.5 * volT * volT) / volT;
+            d2 = d1 - volT;
+        }
+
+        double bsCall(double S, double K, double r, double sigma, double tau) {
+            if (K <= 0.0)
+                return S;
+            double d1, d2;
+            bsD(S, K, r, sigma, tau, d1, d2);
+            return S * normCdf(d1) - K * std::exp(-r * tau) * normCdf(d2);
+        }
+
+        double bsPut(double S, double K, double r, double sigma, double tau) {
+            if (K <= 0.0)
+                return 0.0;
+            double d1, d2;
+            bsD(S, K, r, sigma, tau, d1, d2);
+            return K * std::exp(-r * tau) * normCdf(-d2) - S * normCdf(-d1);
+        }
+
+        /// Cash-or-nothing : 1 si S_T > K
+        double bsDigitCall(double S, double K, double r, double sigma, double tau) {
+            if (K <= 0.0)
+                return std::exp(-r * tau);
+            double d1, d2;
+            bsD(S, K, r, sigma, tau, d1, d2);
+            return std::exp(-r * tau) * normCdf(d2);
+        }
+
+    } // namespace
+
+    void Payoff::evaluate(const double* S, double* out, int n) const {
+        for (int i = 0; i < n; ++i)
+            out[i] = (*this)(S[i]);
+    }
+
+    double Payoff::strike() const {
+        return 0.0;
+    }
+
+    double Payoff::blackScholes(double, double, double, double) const {
+        throw std::invalid_argument("Pas de formule de Black-Scholes pour ce payoff");
+    }
+
+    ExerciseRegion Payoff::exerciseRegion() const {
+        return ExerciseRegion::Unknown;
+    }
+
     PayoffCall::PayoffCall(double K)
         : K_(K)
     {
@@ -14,6 +80,22 @@ namespace opt {
         return std::max<double>(S - K_, 0.0);
     }
 
+    double PayoffCall::strike() const {
+        return K_;
+    }
+
+    double PayoffCall::blackScholes(double S, double r, double sigma, double tau) const {
+        return bsCall(S, K_, r, sigma, tau);
+    }
+
+    ExerciseRegion PayoffCall::exerciseRegion() const {
+        return ExerciseRegion::Above;
+    }
+
+    void PayoffCall::evaluate(const double* S, double* out, int n) const {
+        crr::simd::callValues(S, K_, out, n);
+    }
+
     PayoffPut::PayoffPut(double K)
         : K_(K)
     {
@@ -25,6 +107,22 @@ namespace opt {
         return std::max<double>(K_ - S, 0.0);
     }
 
+    double PayoffPut::strike() const {
+        return K_;
+    }
+
+    double PayoffPut::blackScholes(double S, double r, double sigma, double tau) const {
+        return bsPut(S, K_, r, sigma, tau);
+    }
+
+    ExerciseRegion PayoffPut::exerciseRegion() const {
+        return ExerciseRegion::Below;
+    }
+
+    void PayoffPut::evaluate(const double* S, double* out, int n) const {
+        crr::simd::putValues(S, K_, out, n);
+    }
+
     PayoffDigitCall::PayoffDigitCall(double K)
         : K_(K)
     {
@@ -36,6 +134,14 @@ namespace opt {
         return (S > K_) ? 1.0 : 0.0;
     }
 
+    double PayoffDigitCall::strike() const {
+        return K_;
+    }
+
+    double PayoffDigitCall::blackScholes(double S, double r, double sigma, double tau) const {
+        return bsDigitCall(S, K_, r, sigma, tau);
+    }
+
     PayoffDigitPut::PayoffDigitPut(double K)
         : K_(K)
     {
@@ -47,6 +153,14 @@ namespace opt {
         return (S < K_) ? 1.0 : 0.0;
     }
 
+    double PayoffDigitPut::strike() const {
+        return K_;
+    }
+
+    double PayoffDigitPut::blackScholes(double S, double r, double sigma, double tau) const {
+        return std::exp(-r * tau) - bsDigitCall(S, K_, r, sigma, tau);
+    }
+
     PayoffDoubleDigit::PayoffDoubleDigit(double K1, double K2)
 		: K1_(K1), K2_(K2)
     {
@@ -58,6 +172,14 @@ namespace opt {
         return (S > K1_ && S < K2_) ? 1.0 : 0.0;
     }
 
+    double PayoffDoubleDigit::strike() const {
+        return 0.5 * (K1_ + K2_);
+    }
+
+    double PayoffDoubleDigit::blackScholes(double S, double r, double sigma, double tau) const {
+        return bsDigitCall(S, K1_, r, sigma, tau) - bsDigitCall(S, K2_, r, sigma, tau);
+    }
+
     PayoffBull::PayoffBull(double K1, double K2)
         : K1_(K1), K2_(K2)
     {
@@ -69,6 +191,14 @@ namespace opt {
         return (S < K1_) ? 0.0 : ((S > K2_) ? K2_ - K1_ : S - K1_);
     }
 
+    double PayoffBull::strike() const {
+        return 0.5 * (K1_ + K2_);
+    }
+
+    double PayoffBull::blackScholes(double S, double r, double sigma, double tau) const {
+        return bsCall(S, K1_, r, sigma, tau) - bsCall(S, K2_, r, sigma, tau);
+    }
+
     PayoffBear::PayoffBear(double K1, double K2)
         : K1_(K1), K2_(K2)
     {
@@ -80,6 +210,14 @@ namespace opt {
         return (S < K1_) ? K2_ - K1_ : ((S > K2_) ? 0 : K2_ - S);
     }
 
+    double PayoffBear::strike() const {
+        return 0.5 * (K1_ + K2_);
+    }
+
+    double PayoffBear::blackScholes(double S, double r, double sigma, double tau) const {
+        return bsPut(S, K2_, r, sigma, tau) - bsPut(S, K1_, r, sigma, tau);
+    }
+
     PayoffStrangle::PayoffStrangle(double K1, double K2)
         : K1_(K1), K2_(K2)
     {
@@ -91,6 +229,14 @@ namespace opt {
         return (S < K1_) ? K1_ - S : ((S > K2_) ? S - K2_ : 0);
     }
 
+    double PayoffStrangle::strike() const {
+        return 0.5 * (K1_ + K2_);
+    }
+
+    double PayoffStrangle::blackScholes(double S, double r, double sigma, double tau) const {
+        return bsPut(S, K1_, r, sigma, tau) + bsCall(S, K2_, r, sigma, tau);
+    }
+
     PayoffButterfly::PayoffButterfly(double K1, double K2)
         : K1_(K1), K2_(K2)
     {
@@ -102,4 +248,13 @@ namespace opt {
         return (S > K1_ && S <= 0.5 * (K1_ + K2_)) ? S - K1_ : ((S > 0.5 * (K1_ + K2_) && S < K2_) ? K2_ - S : 0);
     }
 
+    double PayoffButterfly::strike() const {
+        return 0.5 * (K1_ + K2_);
+    }
+
+    double PayoffButterfly::blackScholes(double S, double r, double sigma, double tau) const {
+        double Km = 0.5 * (K1_ + K2_);
+        return bsCall(S, K1_, r, sigma, tau) - 2.0 * bsCall(S, Km, r, sigma, tau) + bsCall(S, K2_, r, sigma, tau);
+    }
+
 } // namespace opt
@@ -5,6 +5,15 @@
 
 namespace opt {
 
+    /**
+     * @brief Position de la région d’exercice anticipé par rapport à la frontière S*(t).
+     */
+    enum class ExerciseRegion {
+        Unknown,  ///< Pas de structure connue : tous les nœuds sont évalués.
+        Below,    ///< Exercice pour S <= S*(t) (put, taux positif).
+        Above     ///< Exercice pour S >= S*(t) (call).
+    };
+
     /**
      * @brief Classe abstraite représentant le payoff d’une option.
      */
@@ -16,6 +25,37 @@ namespace opt {
          * @return Valeur du payoff.
          */
         virtual double operator()(double S) const = 0;
+
+        /**
+         * @brief Évalue le payoff sur un tableau de prix du sous-jacent.
+         * @param S   Prix du sous-jacent.
+         * @param out Valeurs du payoff (n éléments).
+         * @param n   Nombre de prix.
+         */
+        virtual void evaluate(const double* S, double* out, int n) const;
+
+        /**
+         * @brief Strike de référence, sur lequel certaines paramétrisations centrent l’arbre.
+         * @return Strike (milieu des deux strikes pour les payoffs à deux strikes), 0 si aucun.
+         */
+        virtual double strike() const;
+
+        /**
+         * @brief Valeur de Black-Scholes de l’option européenne de ce payoff.
+         * @details Utilisée pour lisser le dernier pas de l’arbre (méthode BBS).
+         * @param S     Prix du sous-jacent.
+         * @param r     Taux sans risque continu.
+         * @param sigma Volatilité.
+         * @param tau   Durée restante jusqu’à l’échéance.
+         * @return Valeur actualisée.
+         */
+        virtual double blackScholes(double S, double r, double sigma, double tau) const;
+
+        /**
+         * @brief Côté de la région d’exercice pour un payoff monotone, utilisé par American pour
+         *        suivre la frontière d’exercice au lieu d’évaluer chaque nœud.
+         */
+        virtual ExerciseRegion exerciseRegion() const;
     };
 
     /**
@@ -32,6 +72,10 @@ namespace opt {
         PayoffCall(double K);
 
         double operator()(double S) const override;
+        double strike() const override;
+        double blackScholes(double S, double r, double sigma, double tau) const override;
+        ExerciseRegion exerciseRegion() const override;
+        void evaluate(const double* S, double* out, int n) const override;
     };
 
     /**
@@ -44,6 +88,10 @@ namespace opt {
     public:
         PayoffPut(double K);
         double operator()(double S) const override;
+        double strike() const override;
+        double blackScholes(double S, double r, double sigma, double tau) const override;
+        ExerciseRegion exerciseRegion() const override;
+        void evaluate(const double* S, double* out, int n) const override;
     };
 
     /**
@@ -56,6 +104,8 @@ namespace opt {
     public:
         PayoffDigitCall(double K);
         double operator()(double S) const override;
+        double strike() const override;
+        double blackScholes(double S, double r, double sigma, double tau) const override;
     };
 
     /**
@@ -68,6 +118,8 @@ namespace opt {
     public:
         PayoffDigitPut(double K);
         double operator()(double S) const override;
+        double strike() const override;
+        double blackScholes(double S, double r, double sigma, double tau) const override;
     };
 
     /**
@@ -86,6 +138,8 @@ namespace opt {
         PayoffDoubleDigit(double K1, double K2);
 
         double operator()(double S) const override;
+        double strike() const override;
+        double blackScholes(double S, double r, double sigma, double tau) const override;
     };
 
     /**
@@ -99,6 +153,8 @@ namespace opt {
     public:
         PayoffBull(double K1, double K2);
         double operator()(double S) const override;
+        double strike() const override;
+        double blackScholes(double S, double r, double sigma, double tau) const override;
     };
 
     /**
@@ -112,6 +168,8 @@ namespace opt {
     public:
         PayoffBear(double K1, double K2);
         double operator()(double S) const override;
+        double strike() const override;
+        double blackScholes(double S, double r, double sigma, double tau) const override;
     };
 
     /**
@@ -125,6 +183,8 @@ namespace opt {
     public:
         PayoffStrangle(double K1, double K2);
         double operator()(double S) const override;
+        double strike() const override;
+        double blackScholes(double S, double r, double sigma, double tau) const override;
     };
 
     /**
@@ -138,6 +198,8 @@ namespace opt {
     public:
         PayoffButterfly(double K1, double K2);
         double operator()(double S) const override;
+        double strike() const override;
+        double blackScholes(double S, double r, double sigma, double tau) const override;
     };
 
 } // namespace opt
@@ -0,0 +1,69 @@
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+#include <cstdint>
+
+namespace crr {
+
+    /**
+     * @brief Stockage des prix du sous-jacent sur l’arbre recombinant.
+     */
+    enum class StockStorage {
+        Full,      ///< Tous les niveaux sont stockés (O(N²) mémoire).
+        Terminal   ///< Seul le niveau terminal est stocké, les niveaux intérieurs sont recalculés (O(N) mémoire).
+    };
+
+    /**
+     * @brief Paramétrisation d’un pas de l’arbre binomial : facteurs U = 1 + u, D = 1 + d,
+     *        probabilité de hausse p et actualisation.
+     */
+    enum class Parameterization {
+        Classic,            ///< u, d = r dt ± σ√dt, p = 1/2, actualisation 1/(1 + r dt) (historique).
+        CoxRossRubinstein,  ///< U = e^{σ√dt}, D = 1/U, p risque-neutre.
+        JarrowRudd,         ///< U, D = e^{(r - σ²/2) dt ± σ√dt}, p risque-neutre.
+        Tian,               ///< Trois premiers moments du log-normal reproduits exactement.
+        LeisenReimer        ///< Inversion de Peizer-Pratt centrée sur le strike (N pair arrondi à N + 1).
+    };
+
+    /**
+     * @brief Lissage du dernier pas de l’arbre par Black-Scholes.
+     * @details Avec Leisen-Reimer, le dernier pas n’est jamais lissé : BBS est sans effet et BBSR
+     *          extrapole des arbres non lissés.
+     */
+    enum class Smoothing {
+        None,  ///< Payoff exact à l’échéance.
+        BBS,   ///< Valeurs au niveau N - 1 données par Black-Scholes sur un pas (BBS).
+        BBSR   ///< BBS extrapolé par Richardson, 2 BBS(N) - BBS(N/2) (options américaines ; BBS sinon).
+    };
+
+    /**
+     * @brief Tirages des trajectoires Monte Carlo.
+     */
+    enum class Sampling {
+        PseudoRandom,  ///< Normales indépendantes (Philox, Box-Muller), erreur en 1/√trajectoires.
+        Sobol          ///< Quasi-Monte Carlo : Sobol brouillé et pont brownien, répété Settings::mcReplicates fois.
+    };
+
+    /**
+     * @brief Paramètres numériques des moteurs d’arbres et de Monte Carlo.
+     */
+    struct Settings {
+        StockStorage storage = StockStorage::Terminal;  ///< Stockage de l’arbre du sous-jacent
+        Parameterization parameterization = Parameterization::Classic;  ///< Paramétrisation des pas
+        double strike = 0.0;   ///< Strike de Leisen-Reimer (0 : celui du payoff, à défaut S0)
+        Smoothing smoothing = Smoothing::None;  ///< Lissage du dernier pas
+        int tileWidth = 0;     ///< Largeur des tuiles de price() en nœuds (0 : rétropropagation non pavée)
+        int tileLevels = 256;  ///< Nombre de niveaux avancés par tuile (ou par bloc parallèle)
+        int threads = 1;             ///< Threads de price() (1 : séquentiel, 0 : tous les cœurs)
+        int parallelCutoff = 8192;   ///< Taille de niveau en dessous de laquelle price() est séquentiel
+        int richardsonLevels = 3;    ///< Arbres de l’échelle de Richardson par défaut : N, 2N, 4N, ...
+        int mcSteps = 100;           ///< Pas de temps des trajectoires Monte Carlo (au plus 481 en mode Sobol)
+        int mcPaths = 10000;         ///< Nombre de trajectoires Monte Carlo (arrondi à mcReplicates 2^m en mode Sobol)
+        std::uint64_t mcSeed = 42;   ///< Graine de Monte Carlo (clé du générateur Philox, brouillage de Sobol)
+        Sampling mcSampling = Sampling::PseudoRandom;  ///< Tirages des trajectoires
+        int mcReplicates = 16;       ///< Répétitions brouillées indépendantes du mode Sobol (erreur type)
+    };
+
+} // namespace crr
+
+#endif // SETTINGS_H
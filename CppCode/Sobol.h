@@ -0,0 +1,53 @@
+#ifndef SOBOL_H
+#define SOBOL_H
+
+#include <cstdint>
+#include <vector>
+
+namespace crr {
+
+    /**
+     * @brief Suite de Sobol, éventuellement brouillée (Matoušek : brouillage linéaire et décalage
+     *        digital).
+     * @details La dimension 1 est la suite de van der Corput ; la dimension d > 1 utilise le
+     *          (d - 1)-ième polynôme primitif sur GF(2), par degré croissant, et les nombres
+     *          directeurs initiaux de Joe et Kuo (2008), choisis pour la qualité des projections
+     *          à deux dimensions ; leur table couvre les polynômes jusqu'au degré 12, soit
+     *          maxDimensions dimensions. scrambled() tire un brouillage de la graine : chaque graine donne une
+     *          réalisation aléatoire de la suite, uniforme sur [0, 1[^d, dont la structure de
+     *          réseau (t, m, s) est préservée. Les points sont parcourus dans l'ordre du code de
+     *          Gray, de sorte que les 2^m premiers points sont ceux de la suite.
+     */
+    class Sobol {
+    public:
+        static const int bits = 32;             ///< Précision des points en bits
+        static const int maxDimensions = 481;   ///< Dimensions couvertes par la table de Joe et Kuo
+
+    private:
+        int dims_;
+        std::vector<std::uint32_t> direction_;  ///< Nombres directeurs, bits par dimension
+        std::vector<std::uint32_t> shift_;      ///< Décalage digital de chaque dimension
+
+    public:
+        /**
+         * @param dims Nombre de dimensions, de 1 à maxDimensions.
+         */
+        explicit Sobol(int dims);
+
+        int dimensions() const { return dims_; }
+
+        /**
+         * @brief Copie de la suite brouillée par la graine seed.
+         */
+        Sobol scrambled(std::uint64_t seed) const;
+
+        /**
+         * @brief Points first à first + count - 1, par dimension : u[d count + i] est la
+         *        coordonnée d du point first + i, dans ]0, 1[.
+         */
+        void points(std::uint32_t first, int count, double* u) const;
+    };
+
+} // namespace crr
+
+#endif // SOBOL_H
@@ -0,0 +1,50 @@
+#include "pch.h"
+#include "StockTree.h"
+#include <stdexcept>
+
+namespace crr {
+
+    StockTree::StockTree(double S0, double u, double d, int N, StockStorage storage)
+        : S0_(S0), N_(N), storage_(storage), upPow_(N + 1), downPow_(N + 1), terminal_(N + 1)
+    {
+        upPow_[0] = 1.0;
+        downPow_[0] = 1.0;
+        for (int k = 1; k <= N_; ++k) {
+            upPow_[k] = upPow_[k - 1] * (1 + u);
+            downPow_[k] = downPow_[k - 1] * (1 + d);
+        }
+        for (int i = 0; i <= N_; ++i)
+            terminal_[i] = S0_ * upPow_[i] * downPow_[N_ - i];
+
+        if (storage_ == StockStorage::Full) {
+            lattice_ = TriangularLattice(N_ + 1);
+            for (int n = 0; n <= N_; ++n) {
+                auto S = lattice_[n];
+                for (int i = 0; i <= n; ++i)
+                    S[i] = S0_ * upPow_[i] * downPow_[n - i];
+            }
+        }
+    }
+
+    const double* StockTree::level(int n, double* scratch) const {
+        return range(n, 0, n + 1, scratch);
+    }
+
+    const double* StockTree::range(int n, int i0, int count, double* scratch) const {
+        if (storage_ == StockStorage::Full)
+            return lattice_[n].data() + i0;
+        if (n == N_)
+            return terminal_.data() + i0;
+        for (int i = 0; i < count; ++i)
+            scratch[i] = S0_ * upPow_[i0 + i] * downPow_[n - i0 - i];
+        return scratch;
+    }
+
+    StockTreeNR::StockTreeNR(double S0, double u, double d, int N)
+        : tree_(S0, u, d, N, StockStorage::Terminal)
+    {
+        if (N >= 31)
+            throw std::invalid_argument("N trop grand pour l'arbre non recombinant");
+    }
+
+} // namespace crr
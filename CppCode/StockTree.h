@@ -0,0 +1,110 @@
+#ifndef STOCKTREE_H
+#define STOCKTREE_H
+
+#include "Lattice.h"
+#include "Settings.h"
+#include <cstdint>
+#include <vector>
+
+namespace crr {
+
+    /**
+     * @brief Arbre binomial recombinant des prix du sous-jacent, sans appel à std::pow.
+     * @details Les tables (1 + u)^i et (1 + d)^k sont construites une fois par multiplications
+     *          successives ; le prix au nœud (n, i) vaut S0 (1 + u)^i (1 + d)^(n - i), soit deux
+     *          multiplications. Les deux modes de stockage renvoient exactement les mêmes valeurs.
+     */
+    class StockTree {
+    private:
+        double S0_;
+        int N_;
+        StockStorage storage_;
+        std::vector<double> upPow_;    ///< (1 + u)^i, i = 0..N
+        std::vector<double> downPow_;  ///< (1 + d)^k, k = 0..N
+        std::vector<double> terminal_; ///< Niveau N
+        TriangularLattice lattice_;    ///< Tous les niveaux (StockStorage::Full uniquement)
+
+    public:
+        StockTree() : S0_(0.0), N_(0), storage_(StockStorage::Terminal) {}
+
+        /**
+         * @param S0      Prix initial du sous-jacent.
+         * @param u       Rendement d’un pas à la hausse.
+         * @param d       Rendement d’un pas à la baisse.
+         * @param N       Nombre de pas.
+         * @param storage Niveaux conservés en mémoire.
+         */
+        StockTree(double S0, double u, double d, int N, StockStorage storage);
+
+        /**
+         * @brief Prix du sous-jacent au nœud (n, i).
+         */
+        double operator()(int n, int i) const {
+            return storage_ == StockStorage::Full ? lattice_(n, i) : S0_ * upPow_[i] * downPow_[n - i];
+        }
+
+        /**
+         * @brief Niveau n de l’arbre.
+         * @param n       Niveau demandé.
+         * @param scratch Tampon d’au moins n + 1 valeurs, rempli si le niveau n’est pas stocké.
+         * @return Pointeur vers les n + 1 prix du niveau.
+         */
+        const double* level(int n, double* scratch) const;
+
+        /**
+         * @brief Portion du niveau n : prix des nœuds (n, i0) à (n, i0 + count - 1).
+         * @param scratch Tampon d’au moins count valeurs, rempli si le niveau n’est pas stocké.
+         * @return Pointeur vers les count prix demandés.
+         */
+        const double* range(int n, int i0, int count, double* scratch) const;
+
+        int steps() const { return N_; }
+        StockStorage storage() const { return storage_; }
+    };
+
+    /**
+     * @brief Nombre de bits à 1 de x.
+     */
+    inline int popcount(std::uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcount(x);
+#else
+        x = x - ((x >> 1) & 0x55555555u);
+        x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+        x = (x + (x >> 4)) & 0x0F0F0F0Fu;
+        return static_cast<int>((x * 0x01010101u) >> 24);
+#endif
+    }
+
+    /**
+     * @brief Arbre binomial non recombinant des prix du sous-jacent, sans stockage par nœud.
+     * @details Le nœud j du niveau n (fils 2j en baisse, 2j + 1 en hausse) correspond à la
+     *          trajectoire dont les bits de j sont les hausses : son prix est celui du nœud
+     *          recombinant (n, popcount(j)). Mémoire O(N) au lieu de 2^(N+1) prix.
+     */
+    class StockTreeNR {
+    private:
+        StockTree tree_;  ///< Tables des puissances (niveau N seul stocké)
+
+    public:
+        StockTreeNR() = default;
+
+        /**
+         * @param S0 Prix initial du sous-jacent.
+         * @param u  Rendement d’un pas à la hausse.
+         * @param d  Rendement d’un pas à la baisse.
+         * @param N  Nombre de pas (au plus 30).
+         */
+        StockTreeNR(double S0, double u, double d, int N);
+
+        /**
+         * @brief Prix du sous-jacent au nœud j du niveau n (0 <= j < 2^n).
+         */
+        double operator()(int n, std::uint32_t j) const { return tree_(n, popcount(j)); }
+
+        int steps() const { return tree_.steps(); }
+    };
+
+} // namespace crr
+
+#endif // STOCKTREE_H
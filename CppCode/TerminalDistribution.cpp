@@ -0,0 +1,89 @@
+#include "pch.h"
+#include "TerminalDistribution.h"
+#include "StockTree.h"
+#include "Kernels.h"
+#include <cmath>
+#include <algorithm>
+#include <mutex>
+#include <deque>
+#include <stdexcept>
+
+namespace crr {
+
+    TerminalDistribution::TerminalDistribution(double S0, double u, double d, double discount, double p, int N)
+        : prices_(N + 1), weights_(N + 1)
+    {
+        if (N <= 0)             throw std::invalid_argument("N doit être > 0");
+        if (p <= 0.0 || p >= 1.0) throw std::invalid_argument("Probabilité hors de ]0, 1[");
+
+        // Mêmes prix terminaux que les moteurs d’arbres
+        StockTree stock(S0, u, d, N, StockStorage::Terminal);
+        const double* SN = stock.level(N, nullptr);
+        for (int i = 0; i <= N; ++i)
+            prices_[i] = SN[i];
+
+        // log C(N, i) + i log p + (N - i) log(1 - p), décalé de son maximum pour éviter le sous-dépassement
+        double step = std::log(p) - std::log(1.0 - p);
+        std::vector<double> logW(N + 1);
+        double logC = 0.0, logMax = -HUGE_VAL;
+        for (int i = 0; i <= N; ++i) {
+            if (i > 0)
+                logC += std::log(double(N - i + 1) / i);
+            logW[i] = logC + i * step;
+            logMax = std::max<double>(logMax, logW[i]);
+        }
+        // Normalisation : la somme des poids vaut exactement discount^N (élimine l’erreur commune d’arrondi)
+        double sum = 0.0;
+        for (int i = 0; i <= N; ++i) {
+            weights_[i] = std::exp(logW[i] - logMax);
+            sum += weights_[i];
+        }
+        double scale = std::pow(discount, N) / sum;
+        for (int i = 0; i <= N; ++i)
+            weights_[i] *= scale;
+    }
+
+    std::shared_ptr<const TerminalDistribution> TerminalDistribution::get(double S0, double u, double d,
+        double discount, double p, int N)
+    {
+        struct Entry {
+            double S0, u, d, discount, p;
+            int N;
+            std::shared_ptr<const TerminalDistribution> dist;
+        };
+        static const std::size_t capacity = 8;
+        static std::mutex mtx;
+        static std::deque<Entry> cache;
+
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            for (const auto& e : cache) {
+                if (e.S0 == S0 && e.u == u && e.d == d && e.discount == discount && e.p == p && e.N == N)
+                    return e.dist;
+            }
+        }
+
+        // Construction hors verrou : deux threads peuvent calculer la même distribution, sans conséquence
+        auto dist = std::make_shared<const TerminalDistribution>(S0, u, d, discount, p, N);
+        std::lock_guard<std::mutex> lock(mtx);
+        cache.push_front(Entry{ S0, u, d, discount, p, N, dist });
+        if (cache.size() > capacity)
+            cache.pop_back();
+        return dist;
+    }
+
+    double TerminalDistribution::dot(const double* values) const {
+        return simd::dot(weights_.data(), values, int(weights_.size()));
+    }
+
+    std::vector<double> TerminalDistribution::price(const std::vector<const opt::Payoff*>& payoffs) const {
+        std::vector<double> result(payoffs.size());
+        AlignedVector values(prices_.size());
+        for (std::size_t k = 0; k < payoffs.size(); ++k) {
+            payoffs[k]->evaluate(prices_.data(), values.data(), int(prices_.size()));
+            result[k] = dot(values.data());
+        }
+        return result;
+    }
+
+} // namespace crr
@@ -0,0 +1,72 @@
+#ifndef TERMINALDISTRIBUTION_H
+#define TERMINALDISTRIBUTION_H
+
+#include "Lattice.h"
+#include "Payoff.h"
+#include <vector>
+#include <memory>
+
+namespace crr {
+
+    /**
+     * @brief Distribution terminale actualisée de l’arbre binomial recombinant.
+     * @details Pour un payoff européen, le prix vaut sum_i w_i payoff(S_N,i) avec
+     *          w_i = discount^N C(N, i) p^i (1 - p)^(N - i). Les poids sont calculés en
+     *          espace logarithmique (pas de sous-dépassement pour N grand) puis chaque
+     *          payoff se valorise par un produit scalaire en O(N).
+     */
+    class TerminalDistribution {
+    private:
+        AlignedVector prices_;   ///< Prix terminaux S_N,i
+        AlignedVector weights_;  ///< Poids actualisés w_i
+
+    public:
+        /**
+         * @param S0       Prix initial du sous-jacent.
+         * @param u        Rendement d’un pas à la hausse.
+         * @param d        Rendement d’un pas à la baisse.
+         * @param discount Facteur d’actualisation d’un pas.
+         * @param p        Probabilité risque-neutre de hausse.
+         * @param N        Nombre de pas.
+         */
+        TerminalDistribution(double S0, double u, double d, double discount, double p, int N);
+
+        /**
+         * @brief Distribution partagée, construite une seule fois par jeu de paramètres.
+         * @details Les dernières distributions demandées sont conservées dans un cache protégé par mutex.
+         */
+        static std::shared_ptr<const TerminalDistribution> get(double S0, double u, double d,
+            double discount, double p, int N);
+
+        int steps() const { return int(prices_.size()) - 1; }
+        const AlignedVector& prices() const { return prices_; }
+        const AlignedVector& weights() const { return weights_; }
+
+        /**
+         * @brief Prix d’un payoff européen (produit scalaire avec les poids).
+         */
+        template<typename TPayoff>
+        double price(const TPayoff& payoff) const;
+
+        /**
+         * @brief Prix d’un lot de payoffs quelconques sur la même distribution.
+         * @return Un prix par payoff, dans l’ordre du lot.
+         */
+        std::vector<double> price(const std::vector<const opt::Payoff*>& payoffs) const;
+
+        /**
+         * @brief Produit scalaire avec les poids (noyau vectoriel).
+         */
+        double dot(const double* values) const;
+    };
+
+    template<typename TPayoff>
+    double TerminalDistribution::price(const TPayoff& payoff) const {
+        AlignedVector values(prices_.size());
+        payoff.evaluate(prices_.data(), values.data(), int(prices_.size()));
+        return dot(values.data());
+    }
+
+} // namespace crr
+
+#endif // TERMINALDISTRIBUTION_H
@@ -0,0 +1,361 @@
+// Mesures de performance des moteurs : chaque section imprime le tableau d'une optimisation
+// (temps et mémoire selon N, ...). Les temps sont en millisecondes, meilleur de plusieurs
+// répétitions d'au moins 200 ms au total ; ils dépendent de la machine, seuls les rapports comptent.
+//
+// Exécutable autonome, hors de la DLL : compiler ce fichier avec les sources de CppCode sauf
+// Exports.cpp, depuis ce dossier (pch.h vide fourni ici), par exemple
+//     g++ -std=c++17 -O2 -I. -I.. Benchmark.cpp $(ls ../*.cpp | grep -v Exports) -pthread
+// Sans argument, toutes les sections ; sinon les sections nommées (par exemple ./a.out arbre).
+
+#include "European.h"
+#include "American.h"
+#include "Asian.h"
+#include "Kernels.h"
+#include "Payoff.h"
+#include "Trinomial.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace {
+
+    volatile double sink;  ///< Résultats consommés, pour que le compilateur garde les calculs
+
+    /**
+     * @brief Meilleur temps de f en millisecondes.
+     * @details Au moins trois répétitions et 200 ms au total, au plus 1000 répétitions.
+     */
+    template<typename F>
+    double bestTime(F&& f) {
+        using clock = std::chrono::steady_clock;
+        double best = 1e300, total = 0.0;
+        for (int k = 0; k < 1000 && (k < 3 || total < 200.0); ++k) {
+            auto start = clock::now();
+            sink = f();
+            double ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+            best = std::min(best, ms);
+            total += ms;
+        }
+        return best;
+    }
+
+    double megabytes(std::size_t doubles) {
+        return doubles * sizeof(double) / (1024.0 * 1024.0);
+    }
+
+    /**
+     * @brief Chemin arbre (treePrice, treillis complet) contre tampon glissant (price, N + 1 valeurs).
+     * @details La mémoire est celle des valeurs de l'option allouées par chaque chemin : treillis de
+     *          (N + 1)(N + 2)/2 valeurs plus le tampon de N + 1 valeurs pour treePrice(), tampon seul
+     *          pour price(). Les prix du sous-jacent (Settings::storage) sont communs aux deux chemins.
+     */
+    void tree() {
+        std::printf("Arbre complet contre tampon glissant (call européen, put américain, K = 100)\n");
+        std::printf("%7s  %-9s %12s %12s %12s %12s\n", "N", "option", "arbre ms", "tampon ms", "arbre Mo", "tampon Mo");
+        for (int N : { 100, 1000, 2000, 5000 }) {
+            crr::European<opt::PayoffCall> call(100, 0.05, 0.2, 1, N, opt::PayoffCall(100));
+            crr::American<opt::PayoffPut> put(100, 0.05, 0.2, 1, N, opt::PayoffPut(100));
+            double tree = megabytes(crr::TriangularLattice::offset(N + 1) + N + 1), buffer = megabytes(N + 1);
+            std::printf("%7d  %-9s %12.3f %12.3f %12.3f %12.4f\n", N, "européen",
+                bestTime([&] { return call.treePrice()(0, 0); }), bestTime([&] { return call.price(); }), tree, buffer);
+            std::printf("%7d  %-9s %12.3f %12.3f %12.3f %12.4f\n", N, "américain",
+                bestTime([&] { return put.treePrice()(0, 0); }), bestTime([&] { return put.price(); }), tree, buffer);
+        }
+    }
+
+    /**
+     * @brief price() sous chaque jeu d'instructions supporté (simd::setIsa), contre le chemin scalaire.
+     */
+    void kernels() {
+        using crr::simd::Isa;
+        const Isa isas[] = { Isa::Scalar, Isa::SSE2, Isa::AVX2, Isa::AVX512 };
+        const char* names[] = { "Scalar", "SSE2", "AVX2", "AVX512" };
+        int count = int(crr::simd::detectedIsa()) + 1;
+
+        std::printf("Noyaux vectoriels : price() en ms (rapport au chemin scalaire), K = 100\n");
+        std::printf("%7s  %-9s", "N", "option");
+        for (int k = 0; k < count; ++k)
+            std::printf(" %16s", names[k]);
+        std::printf("\n");
+        for (int N : { 1000, 10000, 50000 }) {
+            crr::European<opt::PayoffCall> call(100, 0.05, 0.2, 1, N, opt::PayoffCall(100));
+            crr::American<opt::PayoffPut> put(100, 0.05, 0.2, 1, N, opt::PayoffPut(100));
+            for (int american = 0; american < 2; ++american) {
+                std::printf("%7d  %-9s", N, american ? "américain" : "européen");
+                double scalar = 0.0;
+                for (int k = 0; k < count; ++k) {
+                    crr::simd::setIsa(isas[k]);
+                    double ms = american ? bestTime([&] { return put.price(); }) : bestTime([&] { return call.price(); });
+                    if (k == 0)
+                        scalar = ms;
+                    std::printf(" %9.3f (%4.1fx)", ms, scalar / ms);
+                }
+                std::printf("\n");
+            }
+        }
+        crr::simd::setIsa(crr::simd::detectedIsa());
+    }
+
+    /**
+     * @brief price() pavé dans le temps (Settings::tileWidth, tileLevels) contre non pavé.
+     * @details Le débit apparent compte 16 octets par nœud (une lecture et une écriture du tampon) :
+     *          au-delà du débit mémoire de la machine, les tuiles restent en cache. Non pavé, le put
+     *          américain suit la frontière d'exercice et n'évalue pas l'exercice en continuation.
+     */
+    void tiling() {
+        const int configs[][2] = { { 0, 0 }, { 1024, 128 }, { 2048, 256 }, { 4096, 512 } };
+        std::printf("Pavage dans le temps : price() en ms et débit apparent en Go/s, K = 100\n");
+        std::printf("%7s  %-9s", "N", "option");
+        for (auto& config : configs) {
+            char label[32];
+            std::snprintf(label, sizeof(label), config[0] ? "%d x %d" : "non pavé", config[0], config[1]);
+            std::printf(" %19s", label);
+        }
+        std::printf("\n");
+        for (int N : { 10000, 50000 }) {
+            double bytes = 16.0 * crr::TriangularLattice::offset(N + 1);
+            for (int american = 0; american < 2; ++american) {
+                std::printf("%7d  %-9s", N, american ? "américain" : "européen");
+                for (auto& config : configs) {
+                    crr::Settings settings;
+                    settings.tileWidth = config[0];
+                    settings.tileLevels = config[0] ? config[1] : settings.tileLevels;
+                    crr::European<opt::PayoffCall> call(100, 0.05, 0.2, 1, N, opt::PayoffCall(100), settings);
+                    crr::American<opt::PayoffPut> put(100, 0.05, 0.2, 1, N, opt::PayoffPut(100), settings);
+                    double ms = american ? bestTime([&] { return put.price(); }) : bestTime([&] { return call.price(); });
+                    std::printf(" %10.2f (%5.1f)", ms, bytes / ms * 1e-6);
+                }
+                std::printf("\n");
+            }
+        }
+    }
+
+    /**
+     * @brief Erreur et temps de price() selon la paramétrisation, à N impair.
+     * @details Références : Black-Scholes pour le call européen ; pour le put américain, Leisen-Reimer
+     *          à 10001 et 20001 pas extrapolé en 1/N (2 V(20001) - V(10001)).
+     */
+    void parameterizations() {
+        using crr::Parameterization;
+        const Parameterization kinds[] = { Parameterization::Classic, Parameterization::CoxRossRubinstein,
+            Parameterization::JarrowRudd, Parameterization::Tian, Parameterization::LeisenReimer };
+        const char* names[] = { "Classic", "CRR", "JarrowRudd", "Tian", "LeisenReimer" };
+
+        const double S0 = 100, R = 0.05, sigma = 0.2, T = 1, K = 100;
+        crr::Settings lr;
+        lr.parameterization = Parameterization::LeisenReimer;
+        double american = 2.0 * crr::American<opt::PayoffPut>(S0, R, sigma, T, 20001, opt::PayoffPut(K), lr).price()
+            - crr::American<opt::PayoffPut>(S0, R, sigma, T, 10001, opt::PayoffPut(K), lr).price();
+        double european = opt::PayoffCall(K).blackScholes(S0, R, sigma, T);
+
+        std::printf("Convergence selon la paramétrisation : erreur (temps en ms), S0 = K = 100\n");
+        std::printf("%-13s %6s %22s %22s\n", "paramétrisation", "N", "call européen", "put américain");
+        for (int k = 0; k < 5; ++k) {
+            crr::Settings settings;
+            settings.parameterization = kinds[k];
+            for (int N : { 101, 1001, 5001 }) {
+                crr::European<opt::PayoffCall> call(S0, R, sigma, T, N, opt::PayoffCall(K), settings);
+                crr::American<opt::PayoffPut> put(S0, R, sigma, T, N, opt::PayoffPut(K), settings);
+                double callMs = bestTime([&] { return call.price(); }), putMs = bestTime([&] { return put.price(); });
+                std::printf("%-13s %6d %+12.2e (%7.3f) %+12.2e (%7.3f)\n", names[k], N,
+                    call.price() - european, callMs, put.price() - american, putMs);
+            }
+        }
+    }
+
+    /**
+     * @brief Plus petit N de la grille à partir duquel l'erreur reste sous la cible (0 si aucun).
+     */
+    int required(const std::vector<int>& grid, const std::vector<double>& errors, double target) {
+        int N = 0;
+        for (std::size_t k = grid.size(); k-- > 0 && std::fabs(errors[k]) <= target;)
+            N = grid[k];
+        return N;
+    }
+
+    /**
+     * @brief Précision égale : N et temps nécessaires à chaque moteur pour une erreur cible.
+     * @details Le N retenu est le premier de la grille (progression de 20 %) au-delà duquel toutes les
+     *          erreurs restent sous la cible, ce qui écarte les N isolés favorisés par l'oscillation.
+     */
+    void matched(const char* name, double reference, const std::function<double(int, int)>& price) {
+        const char* engines[] = { "trinomial", "binomial Classic", "binomial CRR" };
+        std::vector<int> grid;
+        for (double N = 10; N <= 8000; N *= 1.2)
+            grid.push_back(int(N));
+
+        std::printf("%s\n", name);
+        std::printf("%8s", "cible");
+        for (const char* engine : engines)
+            std::printf(" %24s", engine);
+        std::printf("\n");
+        std::vector<double> errors[3];
+        for (int e = 0; e < 3; ++e) {
+            for (int N : grid)
+                errors[e].push_back(price(e, N) - reference);
+        }
+        for (double target : { 1e-2, 1e-3, 2e-4 }) {
+            std::printf("%8.0e", target);
+            for (int e = 0; e < 3; ++e) {
+                int N = required(grid, errors[e], target);
+                if (N == 0)
+                    std::printf(" %24s", "-");
+                else
+                    std::printf("    N = %5d (%8.3f ms)", N, bestTime([&] { return price(e, N); }));
+            }
+            std::printf("\n");
+        }
+    }
+
+    /**
+     * @brief Arbre trinomial contre arbres binomiaux à précision égale.
+     * @details Références : Black-Scholes pour le call européen ; pour le put américain, Leisen-Reimer
+     *          à 10001 et 20001 pas extrapolé en 1/N.
+     */
+    void trinomial() {
+        const double S0 = 100, R = 0.05, sigma = 0.2, T = 1;
+        crr::Settings settings[3], lr;
+        settings[2].parameterization = crr::Parameterization::CoxRossRubinstein;
+        lr.parameterization = crr::Parameterization::LeisenReimer;
+
+        std::printf("Arbre trinomial à précision égale : N et temps de price() pour une erreur cible\n");
+        for (double K : { 100.0, 110.0 }) {
+            opt::PayoffCall call(K);
+            opt::PayoffPut put(K);
+            char name[64];
+            std::snprintf(name, sizeof(name), "call européen, K = %g", K);
+            matched(name, call.blackScholes(S0, R, sigma, T), [&](int e, int N) {
+                return e == 0 ? crr::Trinomial<opt::PayoffCall>(S0, R, sigma, T, N, call).price()
+                    : crr::European<opt::PayoffCall>(S0, R, sigma, T, N, call, settings[e]).price();
+            });
+            double reference = 2.0 * crr::American<opt::PayoffPut>(S0, R, sigma, T, 20001, put, lr).price()
+                - crr::American<opt::PayoffPut>(S0, R, sigma, T, 10001, put, lr).price();
+            std::snprintf(name, sizeof(name), "put américain, K = %g", K);
+            matched(name, reference, [&](int e, int N) {
+                return e == 0 ? crr::Trinomial<opt::PayoffPut>(S0, R, sigma, T, N, put, crr::Exercise::American).price()
+                    : crr::American<opt::PayoffPut>(S0, R, sigma, T, N, put, settings[e]).price();
+            });
+        }
+    }
+
+    /**
+     * @brief Options asiatiques sur l'arbre non recombinant : terminalValues() (2^N valeurs) et price()
+     *        (parcours en profondeur), moyennes arithmétique et géométrique.
+     */
+    void asian() {
+        std::printf("Asiatiques sur l'arbre non recombinant : temps en ms, call K = 100\n");
+        std::printf("%4s %22s %22s\n", "N", "arithmétique", "géométrique");
+        std::printf("%4s %11s %10s %11s %10s\n", "", "terminales", "prix", "terminales", "prix");
+        for (int N : { 16, 18, 20, 22, 24 }) {
+            crr::Asian<opt::PayoffCall, crr::Arithmetic> arithmetic(100, 0.05, 0.2, 1, N, opt::PayoffCall(100),
+                crr::Arithmetic());
+            crr::Asian<opt::PayoffCall, crr::Geometric> geometric(100, 0.05, 0.2, 1, N, opt::PayoffCall(100),
+                crr::Geometric());
+            std::printf("%4d %11.2f %10.2f %11.2f %10.2f\n", N,
+                bestTime([&] { return arithmetic.terminalValues()[0]; }), bestTime([&] { return arithmetic.price(); }),
+                bestTime([&] { return geometric.terminalValues()[0]; }), bestTime([&] { return geometric.price(); }));
+        }
+    }
+
+    /**
+     * @brief Boucle Monte Carlo d'origine : un tirage normal_distribution et un exp par pas de trajectoire.
+     */
+    template<typename TAggregator>
+    double originalMC(double S0, double R, double sigma, double T, const opt::PayoffCall& payoff,
+        const TAggregator& aggregator, int steps, int paths)
+    {
+        std::mt19937_64 rng(42);
+        std::normal_distribution<double> nd(0.0, 1.0);
+        double dt = T / steps;
+        double sum = 0.0;
+        for (int i = 0; i < paths; ++i) {
+            double St = S0, agg = S0;
+            for (int j = 0; j < steps; ++j) {
+                St *= std::exp((R - 0.5 * sigma * sigma) * dt + sigma * std::sqrt(dt) * nd(rng));
+                agg = aggregator(agg, St, j + 1);
+            }
+            sum += payoff(agg);
+        }
+        return std::exp(-R * T) * sum / paths;
+    }
+
+    template<typename TAggregator>
+    void monteCarloRow(const char* name, const TAggregator& aggregator) {
+        using crr::simd::Isa;
+        const Isa isas[] = { Isa::Scalar, Isa::SSE2, Isa::AVX2, Isa::AVX512 };
+        crr::Settings settings;  // 100 pas, 10000 trajectoires, un thread
+        crr::Asian<opt::PayoffCall, TAggregator> option(100, 0.05, 0.2, 1, 10, opt::PayoffCall(100), aggregator, settings);
+
+        double original = bestTime([&] {
+            return originalMC(100, 0.05, 0.2, 1, opt::PayoffCall(100), aggregator, settings.mcSteps, settings.mcPaths);
+        });
+        std::printf("%-13s %10.2f", name, original);
+        for (int k = 0; k <= int(crr::simd::detectedIsa()); ++k) {
+            crr::simd::setIsa(isas[k]);
+            double ms = bestTime([&] { return option.priceMC(); });
+            std::printf(" %9.2f (%4.1fx)", ms, original / ms);
+        }
+        std::printf("\n");
+        crr::simd::setIsa(crr::simd::detectedIsa());
+    }
+
+    /**
+     * @brief Asian::priceMC() sur un cœur sous chaque jeu d'instructions, contre la boucle d'origine
+     *        (std::mt19937_64, normal_distribution et exp par pas).
+     */
+    void monteCarlo() {
+        const char* names[] = { "Scalar", "SSE2", "AVX2", "AVX512" };
+        std::printf("Monte Carlo asiatique, 100 pas x 10000 trajectoires, un thread : ms (accélération)\n");
+        std::printf("%-13s %10s", "moyenne", "origine");
+        for (int k = 0; k <= int(crr::simd::detectedIsa()); ++k)
+            std::printf(" %16s", names[k]);
+        std::printf("\n");
+        monteCarloRow("arithmétique", crr::Arithmetic());
+        monteCarloRow("géométrique", crr::Geometric());
+        monteCarloRow("maximum", crr::LookMax());
+        monteCarloRow("minimum", crr::LookMin());
+    }
+
+    struct Section {
+        const char* name;
+        void (*run)();
+    };
+
+    const Section sections[] = {
+        { "arbre", tree },
+        { "noyaux", kernels },
+        { "pavage", tiling },
+        { "parametrisation", parameterizations },
+        { "trinomial", trinomial },
+        { "asiatique", asian },
+        { "montecarlo", monteCarlo },
+    };
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int ran = 0;
+    for (const Section& section : sections) {
+        bool selected = argc == 1;
+        for (int i = 1; i < argc; ++i)
+            selected = selected || std::strcmp(argv[i], section.name) == 0;
+        if (selected) {
+            std::printf("[%s]\n", section.name);
+            section.run();
+            std::printf("\n");
+            ++ran;
+        }
+    }
+    if (ran == 0) {
+        std::printf("Sections :");
+        for (const Section& section : sections)
+            std::printf(" %s", section.name);
+        std::printf("\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,154 @@
+// Test de American::hedgingStrategyNR() et American::pathPosition() contre une décomposition de
+// Doob calculée directement sur l'arbre non recombinant complet (2^n nœuds au niveau n).
+//
+// Exécutable autonome, hors de la DLL : compiler ce fichier avec les sources de CppCode sauf
+// Exports.cpp, depuis ce dossier (pch.h vide fourni ici), par exemple
+//     g++ -std=c++17 -O2 -I. -I.. HedgingTest.cpp $(ls ../*.cpp | grep -v Exports) -pthread
+// Code de sortie 0 si toutes les comparaisons passent, 1 sinon.
+
+#include "American.h"
+#include "Payoff.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+    /**
+     * @brief Référence : valeurs, compensateur et couverture nœud par nœud sur l'arbre non recombinant.
+     * @details Le nœud j du niveau n a pour fils 2j (baisse) et 2j + 1 (hausse). Aucun nœud n'est
+     *          partagé : chaque trajectoire porte son propre compensateur A, capitalisé d'un pas à
+     *          l'autre, et la couverture est déduite de V + A sans passer par l'arbre recombinant.
+     */
+    struct Reference {
+        std::vector<std::vector<double>> S, V, A, delta, bond;
+    };
+
+    Reference reference(double S0, double K, bool call, double up, double down, double growth, int N) {
+        double q = (growth - down) / (up - down);
+        auto payoff = [&](double S) { return std::max(call ? S - K : K - S, 0.0); };
+
+        Reference ref;
+        ref.S.resize(N + 1);
+        ref.S[0] = { S0 };
+        for (int n = 0; n < N; ++n) {
+            ref.S[n + 1].resize(std::size_t(2) << n);
+            for (std::size_t j = 0; j < ref.S[n].size(); ++j) {
+                ref.S[n + 1][2 * j] = ref.S[n][j] * down;
+                ref.S[n + 1][2 * j + 1] = ref.S[n][j] * up;
+            }
+        }
+
+        // Enveloppe de Snell et incréments du compensateur a = V - continuation >= 0
+        ref.V.resize(N + 1);
+        std::vector<std::vector<double>> a(N);
+        for (double S : ref.S[N])
+            ref.V[N].push_back(payoff(S));
+        for (int n = N - 1; n >= 0; --n) {
+            for (std::size_t j = 0; j < ref.S[n].size(); ++j) {
+                double continuation = (q * ref.V[n + 1][2 * j + 1] + (1.0 - q) * ref.V[n + 1][2 * j]) / growth;
+                double value = std::max(payoff(ref.S[n][j]), continuation);
+                ref.V[n].push_back(value);
+                a[n].push_back(value - continuation);
+            }
+        }
+
+        // Compensateur le long de chaque trajectoire, puis couverture de la martingale V + A
+        ref.A.resize(N + 1);
+        ref.A[0] = { 0.0 };
+        ref.delta.resize(N);
+        ref.bond.resize(N);
+        for (int n = 0; n < N; ++n) {
+            for (std::size_t j = 0; j < ref.S[n].size(); ++j) {
+                double next = (ref.A[n][j] + a[n][j]) * growth;
+                ref.A[n + 1].push_back(next);
+                ref.A[n + 1].push_back(next);
+                double Mu = ref.V[n + 1][2 * j + 1] + next, Md = ref.V[n + 1][2 * j] + next;
+                double dlt = (Mu - Md) / (ref.S[n + 1][2 * j + 1] - ref.S[n + 1][2 * j]);
+                ref.delta[n].push_back(dlt);
+                ref.bond[n].push_back(ref.V[n][j] + ref.A[n][j] - dlt * ref.S[n][j]);
+            }
+        }
+        return ref;
+    }
+
+    int failures = 0;
+
+    void check(double actual, double expected, const char* what, int N, int n, std::size_t j) {
+        if (std::fabs(actual - expected) <= 1e-9 * (1.0 + std::fabs(expected)))
+            return;
+        if (++failures <= 20)
+            std::printf("  %s N=%d noeud (%d, %zu) : %.15g au lieu de %.15g\n", what, N, n, j, actual, expected);
+    }
+
+    template<typename TPayoff>
+    void run(const char* name, double K, bool call, double R, crr::Parameterization parameterization) {
+        const double S0 = 100.0, sigma = 0.25, T = 1.0;
+        crr::Settings settings;
+        settings.parameterization = parameterization;
+
+        int before = failures;
+        for (int N = 1; N <= 16; ++N) {
+            double dt = T / N, sq = sigma * std::sqrt(dt);
+            double up, down, growth;
+            if (parameterization == crr::Parameterization::Classic) {
+                up = 1.0 + R * dt + sq;
+                down = 1.0 + R * dt - sq;
+                growth = 1.0 + R * dt;
+            }
+            else {
+                up = std::exp(sq);
+                down = 1.0 / up;
+                growth = std::exp(R * dt);
+            }
+            Reference ref = reference(S0, K, call, up, down, growth, N);
+
+            // La référence elle-même : le portefeuille (delta, bond) réplique V + A sur les deux fils
+            for (int n = 0; n < N; ++n) {
+                for (std::size_t j = 0; j < ref.S[n].size(); ++j) {
+                    for (std::size_t c = 2 * j; c <= 2 * j + 1; ++c) {
+                        check(ref.delta[n][j] * ref.S[n + 1][c] + ref.bond[n][j] * growth,
+                            ref.V[n + 1][c] + ref.A[n + 1][c], "replication", N, n, j);
+                    }
+                }
+            }
+
+            crr::American<TPayoff> option(S0, R, sigma, T, N, TPayoff(K), settings);
+            auto nr = option.hedgingStrategyNR();
+            auto H = option.hedgingStrategy();
+            for (int n = 0; n < N; ++n) {
+                for (std::size_t j = 0; j < ref.S[n].size(); ++j) {
+                    check(nr.delta[n][j], ref.delta[n][j], "hedgingStrategyNR delta", N, n, j);
+                    check(nr.bond[n][j], ref.bond[n][j], "hedgingStrategyNR bond", N, n, j);
+
+                    // Le pas k de la trajectoire menant au nœud j est le bit n - 1 - k de j
+                    std::vector<bool> moves(n);
+                    for (int k = 0; k < n; ++k)
+                        moves[k] = ((j >> (n - 1 - k)) & 1) != 0;
+                    auto position = option.pathPosition(H, moves);
+                    check(position.delta, ref.delta[n][j], "pathPosition delta", N, n, j);
+                    check(position.bond, ref.bond[n][j], "pathPosition bond", N, n, j);
+                    check(position.compensator, ref.A[n][j], "pathPosition compensator", N, n, j);
+                }
+            }
+        }
+        std::printf("%-5s K=%5.1f R=%+.2f %-5s : %s\n", name, K, R,
+            parameterization == crr::Parameterization::Classic ? "Classic" : "CRR",
+            failures == before ? "ok" : "ECHEC");
+    }
+
+} // namespace
+
+int main() {
+    for (auto parameterization : { crr::Parameterization::Classic, crr::Parameterization::CoxRossRubinstein }) {
+        for (double R : { 0.05, -0.02 }) {
+            for (double K : { 90.0, 100.0, 110.0 }) {
+                run<opt::PayoffPut>("put", K, false, R, parameterization);
+                run<opt::PayoffCall>("call", K, true, R, parameterization);
+            }
+        }
+    }
+    std::printf(failures ? "%d comparaisons en échec\n" : "Toutes les comparaisons passent\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,113 @@
+// Test des noyaux vectoriels (Kernels) : European::price(), American::price(), leurs sensibilités
+// et treePrice() sont identiques au bit près pour chaque jeu d'instructions supporté par la machine
+// (simd::setIsa), à N pair et impair et pour toutes les tailles de reste des boucles vectorielles.
+//
+// Exécutable autonome, hors de la DLL : compiler ce fichier avec les sources de CppCode sauf
+// Exports.cpp, depuis ce dossier (pch.h vide fourni ici), par exemple
+//     g++ -std=c++17 -O2 -I. -I.. KernelTest.cpp $(ls ../*.cpp | grep -v Exports) -pthread
+// Code de sortie 0 si toutes les comparaisons passent, 1 sinon.
+
+#include "American.h"
+#include "European.h"
+#include "Kernels.h"
+#include "Payoff.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+    int failures = 0;
+
+    void expect(bool ok, const char* what) {
+        if (!ok && ++failures <= 20)
+            std::printf("  ECHEC : %s\n", what);
+    }
+
+    bool same(double a, double b) {
+        return std::memcmp(&a, &b, sizeof(double)) == 0;
+    }
+
+    const char* isaName(crr::simd::Isa isa) {
+        switch (isa) {
+        case crr::simd::Isa::SSE2: return "SSE2";
+        case crr::simd::Isa::AVX2: return "AVX2";
+        case crr::simd::Isa::AVX512: return "AVX512";
+        default: return "Scalar";
+        }
+    }
+
+    /**
+     * @brief Résultats d'un moteur sous le jeu d'instructions actif.
+     */
+    struct Results {
+        double price;
+        crr::Option::Greeks greeks;
+        crr::TriangularLattice tree;
+    };
+
+    template<typename TOption>
+    Results results(const TOption& option) {
+        return { option.price(), option.greeks(), option.treePrice() };
+    }
+
+    bool same(const Results& a, const Results& b) {
+        std::size_t count = crr::TriangularLattice::offset(a.tree.size());
+        return same(a.price, b.price) && same(a.greeks.price, b.greeks.price) && same(a.greeks.delta, b.greeks.delta)
+            && same(a.greeks.gamma, b.greeks.gamma) && same(a.greeks.theta, b.greeks.theta)
+            && a.tree.size() == b.tree.size() && std::memcmp(a.tree.data(), b.tree.data(), count * sizeof(double)) == 0;
+    }
+
+    /**
+     * @brief Compare chaque jeu d'instructions supporté au chemin scalaire pour un moteur donné.
+     */
+    template<typename TOption>
+    void compare(const char* name, crr::Parameterization parameterization, int N, const TOption& option) {
+        using crr::simd::Isa;
+        crr::simd::setIsa(Isa::Scalar);
+        Results reference = results(option);
+        for (Isa isa : { Isa::SSE2, Isa::AVX2, Isa::AVX512 }) {
+            if (int(isa) > int(crr::simd::detectedIsa()))
+                break;
+            crr::simd::setIsa(isa);
+            char what[128];
+            std::snprintf(what, sizeof(what), "%s %s N=%d, %s contre Scalar", name,
+                parameterization == crr::Parameterization::Classic ? "Classic" : "CRR", N, isaName(isa));
+            expect(same(results(option), reference), what);
+        }
+    }
+
+} // namespace
+
+int main() {
+    using namespace crr;
+    std::printf("Jeu d'instructions détecté : %s\n", isaName(simd::detectedIsa()));
+
+    // 1 à 40 couvre tous les restes modulo 2, 4 et 8 ; les suivants encadrent les multiples de 8
+    std::vector<int> sizes;
+    for (int N = 1; N <= 40; ++N)
+        sizes.push_back(N);
+    for (int N : { 63, 64, 65, 127, 128, 129, 1000, 1001 })
+        sizes.push_back(N);
+
+    for (auto parameterization : { Parameterization::Classic, Parameterization::CoxRossRubinstein }) {
+        Settings settings;
+        settings.parameterization = parameterization;
+        for (int N : sizes) {
+            compare("European call", parameterization, N,
+                European<opt::PayoffCall>(100, 0.05, 0.2, 1, N, opt::PayoffCall(105), settings));
+            compare("European put", parameterization, N,
+                European<opt::PayoffPut>(100, 0.05, 0.2, 1, N, opt::PayoffPut(95), settings));
+            compare("American put", parameterization, N,
+                American<opt::PayoffPut>(100, 0.05, 0.2, 1, N, opt::PayoffPut(110), settings));
+            compare("American call R<0", parameterization, N,
+                American<opt::PayoffCall>(100, -0.01, 0.3, 1, N, opt::PayoffCall(90), settings));
+            compare("American strangle", parameterization, N,
+                American<opt::PayoffStrangle>(100, 0.05, 0.2, 1, N, opt::PayoffStrangle(90, 110), settings));
+        }
+    }
+    simd::setIsa(simd::detectedIsa());
+
+    std::printf(failures ? "%d comparaisons en échec\n" : "Toutes les comparaisons passent\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,150 @@
+// Test de la rétropropagation parallèle (parallelInduction, ThreadPool) : résultats identiques au
+// bit près au calcul séquentiel pour 1, 2 et 3 threads, et pool toujours utilisable après une
+// exception levée dans une tâche.
+//
+// Exécutable autonome, hors de la DLL : compiler ce fichier avec les sources de CppCode sauf
+// Exports.cpp, depuis ce dossier (pch.h vide fourni ici), par exemple
+//     g++ -std=c++17 -O2 -I. -I.. ThreadPoolTest.cpp $(ls ../*.cpp | grep -v Exports) -pthread
+// Code de sortie 0 si toutes les comparaisons passent, 1 sinon.
+
+#include "American.h"
+#include "European.h"
+#include "Payoff.h"
+#include "Tiling.h"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+    int failures = 0;
+
+    void expect(bool ok, const char* what) {
+        if (!ok && ++failures <= 20)
+            std::printf("  ECHEC : %s\n", what);
+    }
+
+    bool same(double a, double b) {
+        return std::memcmp(&a, &b, sizeof(double)) == 0;
+    }
+
+    // Pas de référence : w[i] = 0.45 w[i + 1] + 0.5 w[i]
+    void step(double* W, int count) {
+        for (int i = 0; i < count; ++i)
+            W[i] = 0.45 * W[i + 1] + 0.5 * W[i];
+    }
+
+    crr::AlignedVector initial(int N) {
+        crr::AlignedVector V(N + 1);
+        for (int i = 0; i <= N; ++i)
+            V[i] = std::max(100.0 - i * 0.37, 0.0) + 1.0 / (i + 1.0);
+        return V;
+    }
+
+    // parallelInduction jusqu'à stop, fin séquentielle, contre la boucle séquentielle complète
+    void induction(int threads, int N, int stop, int levels) {
+        crr::Settings settings;
+        settings.threads = threads;
+        settings.parallelCutoff = 1;
+        settings.tileLevels = levels;
+
+        crr::AlignedVector V = initial(N), W = initial(N);
+        int top = crr::parallelInduction(V.data(), N, stop, settings, [](int, int, int, int count, double* X) {
+            step(X, count);
+        });
+        for (int n = top - 1; n >= stop; --n)
+            step(V.data(), n + 1);
+        for (int n = N - 1; n >= stop; --n)
+            step(W.data(), n + 1);
+
+        bool ok = top >= stop && top <= N;
+        for (int i = 0; i <= stop; ++i)
+            ok = ok && same(V[i], W[i]);
+        char what[128];
+        std::snprintf(what, sizeof(what), "parallelInduction threads=%d N=%d stop=%d niveaux=%d", threads, N, stop, levels);
+        expect(ok, what);
+    }
+
+    template<typename TOption>
+    void engines(const char* name, int threads, int N, const TOption& serial, const TOption& parallel) {
+        auto g1 = serial.greeks(), g2 = parallel.greeks();
+        char what[128];
+        std::snprintf(what, sizeof(what), "%s threads=%d N=%d", name, threads, N);
+        expect(same(serial.price(), parallel.price()) && same(g1.price, g2.price) && same(g1.delta, g2.delta)
+            && same(g1.gamma, g2.gamma) && same(g1.theta, g2.theta), what);
+    }
+
+    // Une tâche lève une exception au milieu de la rétropropagation : l'appelant la reçoit
+    void exception(int threads, int thrower) {
+        crr::Settings settings;
+        settings.threads = threads;
+        settings.parallelCutoff = 1;
+        settings.tileLevels = 4;
+
+        crr::AlignedVector V = initial(1000);
+        bool caught = false;
+        try {
+            crr::parallelInduction(V.data(), 1000, 0, settings, [&](int t, int n, int, int count, double* X) {
+                if (t == thrower && n < 700)
+                    throw std::runtime_error("tâche interrompue");
+                step(X, count);
+            });
+        }
+        catch (const std::runtime_error&) {
+            caught = true;
+        }
+        char what[128];
+        std::snprintf(what, sizeof(what), "exception du thread %d sur %d threads", thrower, threads);
+        expect(caught, what);
+    }
+
+} // namespace
+
+int main() {
+    using namespace crr;
+
+    int cores = threadCount(0);
+    expect(cores >= 1, "threadCount(0) >= 1");
+    expect(threadCount(100000) <= maxThreadsPerCore * cores, "threadCount borné");
+    expect(threadCount(3) == std::min(3, maxThreadsPerCore * cores), "threadCount(3)");
+
+    for (int threads : { 1, 2, 3 }) {
+        for (int N : { 1, 2, 7, 100, 1001, 4096 }) {
+            for (int levels : { 1, 5, 64, 5000 }) {
+                induction(threads, N, 0, levels);
+                induction(threads, N, N / 3, levels);
+            }
+        }
+
+        for (int N : { 499, 1000, 2001 }) {
+            Settings serial, parallel;
+            parallel.threads = threads;
+            parallel.parallelCutoff = 64;
+            parallel.tileLevels = 16;
+            engines("European call", threads, N,
+                European<opt::PayoffCall>(100, 0.05, 0.2, 1, N, opt::PayoffCall(105), serial),
+                European<opt::PayoffCall>(100, 0.05, 0.2, 1, N, opt::PayoffCall(105), parallel));
+            engines("American put", threads, N,
+                American<opt::PayoffPut>(100, 0.05, 0.2, 1, N, opt::PayoffPut(110), serial),
+                American<opt::PayoffPut>(100, 0.05, 0.2, 1, N, opt::PayoffPut(110), parallel));
+            engines("American call R<0", threads, N,
+                American<opt::PayoffCall>(100, -0.01, 0.3, 1, N, opt::PayoffCall(90), serial),
+                American<opt::PayoffCall>(100, -0.01, 0.3, 1, N, opt::PayoffCall(90), parallel));
+        }
+    }
+
+    for (int threads : { 2, 3 }) {
+        for (int thrower = 0; thrower < threads; ++thrower) {
+            exception(threads, thrower);
+            // Le pool reste disponible : la tâche suivante s'exécute en parallèle, avec le même résultat
+            std::atomic<int> ran(0);
+            expect(ThreadPool::instance().run(threads, [&](int) { ++ran; }) && ran == threads,
+                "pool disponible après l'exception");
+            induction(threads, 1001, 0, 8);
+        }
+    }
+
+    std::printf(failures ? "%d comparaisons en échec\n" : "Toutes les comparaisons passent\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,89 @@
+// Test de la rétropropagation pavée (Settings::tileWidth > 0, tiledInduction) : price() et greeks()
+// sont identiques au bit près à la rétropropagation non pavée, y compris pour des largeurs qui ne
+// divisent pas N, des blocs plus hauts que l'arbre et le put américain, dont le chemin non pavé
+// suit la frontière d'exercice.
+//
+// Exécutable autonome, hors de la DLL : compiler ce fichier avec les sources de CppCode sauf
+// Exports.cpp, depuis ce dossier (pch.h vide fourni ici), par exemple
+//     g++ -std=c++17 -O2 -I. -I.. TilingTest.cpp $(ls ../*.cpp | grep -v Exports) -pthread
+// Code de sortie 0 si toutes les comparaisons passent, 1 sinon.
+
+#include "American.h"
+#include "European.h"
+#include "Payoff.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+    int failures = 0;
+
+    void expect(bool ok, const char* what) {
+        if (!ok && ++failures <= 20)
+            std::printf("  ECHEC : %s\n", what);
+    }
+
+    bool same(double a, double b) {
+        return std::memcmp(&a, &b, sizeof(double)) == 0;
+    }
+
+    /**
+     * @brief Compare le moteur pavé (width, levels) au moteur non pavé, mêmes paramètres par ailleurs.
+     */
+    template<typename TOption, typename TPayoff>
+    void compare(const char* name, double R, int N, const TPayoff& payoff, const crr::Settings& base, int width, int levels) {
+        crr::Settings tiled = base;
+        tiled.tileWidth = width;
+        tiled.tileLevels = levels;
+        TOption reference(100, R, 0.2, 1, N, payoff, base), option(100, R, 0.2, 1, N, payoff, tiled);
+
+        auto g1 = reference.greeks(), g2 = option.greeks();
+        char what[160];
+        std::snprintf(what, sizeof(what), "%s N=%d largeur=%d niveaux=%d threads=%d lissage=%d", name, N, width, levels,
+            base.threads, int(base.smoothing));
+        expect(same(reference.price(), option.price()) && same(g1.price, g2.price) && same(g1.delta, g2.delta)
+            && same(g1.gamma, g2.gamma) && same(g1.theta, g2.theta), what);
+    }
+
+    void run(const crr::Settings& settings, int N, int width, int levels) {
+        using namespace crr;
+        compare<European<opt::PayoffCall>>("European call", 0.05, N, opt::PayoffCall(105), settings, width, levels);
+        compare<European<opt::PayoffPut>>("European put", 0.05, N, opt::PayoffPut(95), settings, width, levels);
+        // Non pavé, le put à taux > 0 suit la frontière d'exercice (boundaryInduction)
+        compare<American<opt::PayoffPut>>("American put", 0.05, N, opt::PayoffPut(110), settings, width, levels);
+        compare<American<opt::PayoffCall>>("American call R<0", -0.01, N, opt::PayoffCall(90), settings, width, levels);
+        compare<American<opt::PayoffStrangle>>("American strangle", 0.05, N, opt::PayoffStrangle(90, 110), settings,
+            width, levels);
+    }
+
+} // namespace
+
+int main() {
+    using namespace crr;
+
+    for (int N : { 1, 2, 7, 100, 257, 1000, 1001 }) {
+        for (int width : { 1, 3, 7, 64, 100, 1000, 5000 }) {
+            for (int levels : { 1, 5, 16, 300, 5000 }) {
+                Settings settings;
+                run(settings, N, width, levels);
+            }
+        }
+    }
+
+    // Lissage du dernier pas, puis blocs parallèles suivis de la fin pavée
+    for (int N : { 100, 1001 }) {
+        for (int width : { 7, 100 }) {
+            Settings smoothed;
+            smoothed.smoothing = Smoothing::BBS;
+            run(smoothed, N, width, 16);
+
+            Settings parallel;
+            parallel.threads = 2;
+            parallel.parallelCutoff = 64;
+            run(parallel, N, width, 16);
+        }
+    }
+
+    std::printf(failures ? "%d comparaisons en échec\n" : "Toutes les comparaisons passent\n", failures);
+    return failures ? 1 : 0;
+}
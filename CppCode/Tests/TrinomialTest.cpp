@@ -0,0 +1,122 @@
+// Test de l'arbre trinomial (Trinomial) : price() identique au bit près à treePrice()(0, 0),
+// convergence vers Black-Scholes pour l'option européenne et vers l'arbre binomial pour le put
+// américain, et écartement stretch() borné à [1, 1.5] (sinon sqrt(3/2)).
+//
+// Exécutable autonome, hors de la DLL : compiler ce fichier avec les sources de CppCode sauf
+// Exports.cpp, depuis ce dossier (pch.h vide fourni ici), par exemple
+//     g++ -std=c++17 -O2 -I. -I.. TrinomialTest.cpp $(ls ../*.cpp | grep -v Exports) -pthread
+// Code de sortie 0 si toutes les comparaisons passent, 1 sinon.
+
+#include "American.h"
+#include "Payoff.h"
+#include "Trinomial.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+    int failures = 0;
+
+    void expect(bool ok, const char* what) {
+        if (!ok && ++failures <= 20)
+            std::printf("  ECHEC : %s\n", what);
+    }
+
+    bool same(double a, double b) {
+        return std::memcmp(&a, &b, sizeof(double)) == 0;
+    }
+
+    const double S0 = 100.0, sigma = 0.2, T = 1.0;
+
+    /**
+     * @brief L'écartement est sqrt(3/2), ou une valeur de [1, 1.5] qui place un nœud terminal sur le strike.
+     */
+    template<typename TPayoff>
+    void stretch(const crr::Trinomial<TPayoff>& tree, double R, int N, double K) {
+        double lambda = tree.stretch();
+        double steps = std::fabs(std::log(K / S0)) / (lambda * sigma * std::sqrt(T / N));
+        bool aligned = lambda >= 1.0 && lambda <= 1.5 && std::fabs(steps - std::round(steps)) < 1e-9
+            && std::round(steps) >= 1 && std::round(steps) <= N;
+        char what[128];
+        std::snprintf(what, sizeof(what), "stretch() R=%+.2f N=%d K=%g : %.6f", R, N, K, lambda);
+        expect(lambda == std::sqrt(1.5) || aligned, what);
+    }
+
+    /**
+     * @brief price() contre treePrice()(0, 0), au bit près, et écartement pour une option donnée.
+     */
+    template<typename TPayoff>
+    void consistency(const char* name, double R, int N, double K, crr::Exercise exercise) {
+        crr::Trinomial<TPayoff> tree(S0, R, sigma, T, N, TPayoff(K), exercise);
+        char what[128];
+        std::snprintf(what, sizeof(what), "%s R=%+.2f N=%d K=%g : price() != treePrice()(0, 0)", name, R, N, K);
+        expect(same(tree.price(), tree.treePrice()(0, 0)), what);
+        stretch(tree, R, N, K);
+    }
+
+    /**
+     * @brief |prix - référence| <= tolerance.
+     */
+    void close(const char* name, int N, double K, double price, double reference, double tolerance) {
+        char what[128];
+        std::snprintf(what, sizeof(what), "%s N=%d K=%g : erreur %.3e au-delà de %.1e", name, N, K,
+            price - reference, tolerance);
+        expect(std::fabs(price - reference) <= tolerance, what);
+    }
+
+} // namespace
+
+int main() {
+    using namespace crr;
+
+    for (double R : { 0.05, 0.0, -0.02 }) {
+        for (double K : { 80.0, 95.0, 100.0, 105.0, 130.0 }) {
+            for (int N = 1; N <= 30; ++N) {
+                consistency<opt::PayoffCall>("European call", R, N, K, Exercise::European);
+                consistency<opt::PayoffPut>("American put", R, N, K, Exercise::American);
+            }
+            for (int N : { 50, 100, 1001 }) {
+                consistency<opt::PayoffCall>("European call", R, N, K, Exercise::European);
+                consistency<opt::PayoffPut>("European put", R, N, K, Exercise::European);
+                consistency<opt::PayoffPut>("American put", R, N, K, Exercise::American);
+                consistency<opt::PayoffCall>("American call", R, N, K, Exercise::American);
+            }
+        }
+    }
+
+    // Convergence en 1/N vers Black-Scholes
+    for (double K : { 90.0, 100.0, 110.0 }) {
+        for (int N : { 250, 1000, 4000 }) {
+            double tolerance = 1.0 / N;
+            close("European call", N, K, Trinomial<opt::PayoffCall>(S0, 0.05, sigma, T, N, opt::PayoffCall(K)).price(),
+                opt::PayoffCall(K).blackScholes(S0, 0.05, sigma, T), tolerance);
+            close("European put", N, K, Trinomial<opt::PayoffPut>(S0, 0.05, sigma, T, N, opt::PayoffPut(K)).price(),
+                opt::PayoffPut(K).blackScholes(S0, 0.05, sigma, T), tolerance);
+        }
+    }
+
+    // Put américain contre l'arbre binomial de Leisen-Reimer à 20001 pas
+    Settings lr;
+    lr.parameterization = Parameterization::LeisenReimer;
+    for (double K : { 90.0, 100.0, 110.0 }) {
+        double reference = American<opt::PayoffPut>(S0, 0.05, sigma, T, 20001, opt::PayoffPut(K), lr).price();
+        for (int N : { 250, 1000, 4000 }) {
+            close("American put", N, K, Trinomial<opt::PayoffPut>(S0, 0.05, sigma, T, N, opt::PayoffPut(K),
+                Exercise::American).price(), reference, 1.0 / N);
+        }
+    }
+
+    // Alignement qui demanderait lambda > 1.5 : sqrt(3/2) est conservé et l'erreur reste celle d'un
+    // arbre non aligné
+    for (double K : { 95.0, 105.0 }) {
+        Trinomial<opt::PayoffCall> tree(S0, 0.05, sigma, T, 50, opt::PayoffCall(K));
+        char what[64];
+        std::snprintf(what, sizeof(what), "stretch() N=50 K=%g borné", K);
+        expect(tree.stretch() <= 1.5, what);
+        close("European call", 50, K, tree.price(), opt::PayoffCall(K).blackScholes(S0, 0.05, sigma, T), 2e-2);
+    }
+
+    std::printf(failures ? "%d comparaisons en échec\n" : "Toutes les comparaisons passent\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,3 @@
+// En-tête précompilé vide pour les exécutables de test : les sources de CppCode incluent "pch.h",
+// fourni par le projet Visual Studio de la DLL. Compiler les tests avec -I. depuis ce dossier.
+#pragma once
@@ -0,0 +1,186 @@
+#include "pch.h"
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace crr {
+
+    int threadCount(int requested) {
+        int hw = static_cast<int>(std::thread::hardware_concurrency());
+        if (hw < 1)
+            hw = 1;
+        return requested > 0 ? std::min<int>(requested, maxThreadsPerCore * hw) : hw;
+    }
+
+    bool Barrier::wait() {
+        unsigned gen = generation_.load(std::memory_order_acquire);
+        if (broken_.load(std::memory_order_acquire))
+            return false;
+        if (arrived_.fetch_add(1, std::memory_order_acq_rel) + 1 == count_) {
+            arrived_.store(0, std::memory_order_relaxed);
+            generation_.fetch_add(1, std::memory_order_release);
+            return true;
+        }
+        for (int spin = 0; generation_.load(std::memory_order_acquire) == gen; ++spin) {
+            if (spin >= 1024)
+                std::this_thread::yield();
+        }
+        return !broken_.load(std::memory_order_acquire);
+    }
+
+    void Barrier::abort() {
+        broken_.store(true, std::memory_order_release);
+        generation_.fetch_add(1, std::memory_order_release);
+    }
+
+    ThreadPool::ThreadPool()
+        : busy_(false), task_(nullptr), active_(0), pending_(0), generation_(0)
+    {
+    }
+
+    ThreadPool& ThreadPool::instance() {
+        // Volontairement jamais détruit (voir la classe)
+        static ThreadPool* pool = new ThreadPool;
+        return *pool;
+    }
+
+    void ThreadPool::workerLoop(int index) {
+        unsigned seen = 0;
+        for (;;) {
+            const std::function<void(int)>* task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                start_.wait(lock, [&] { return generation_ != seen && index < active_; });
+                seen = generation_;
+                task = task_;
+            }
+
+            try {
+                (*task)(index);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_)
+                    error_ = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0)
+                done_.notify_one();
+        }
+    }
+
+    bool ThreadPool::run(int threads, const std::function<void(int)>& task) {
+        bool idle = false;
+        if (!busy_.compare_exchange_strong(idle, true))
+            return false;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // Le thread appelant a l’indice 0, le pool fournit les indices 1..threads-1
+            try {
+                while (static_cast<int>(workers_.size()) < threads - 1) {
+                    int index = static_cast<int>(workers_.size()) + 1;
+                    workers_.emplace_back([this, index] { workerLoop(index); });
+                }
+            }
+            catch (...) {
+                // Threads refusés par le système : les threads déjà créés restent au pool,
+                // l’appelant calcule en séquentiel
+                busy_.store(false);
+                return false;
+            }
+            task_ = &task;
+            active_ = threads;
+            pending_ = threads - 1;
+            error_ = nullptr;
+            ++generation_;
+        }
+        start_.notify_all();
+
+        std::exception_ptr error;
+        try {
+            task(0);
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_.wait(lock, [&] { return pending_ == 0; });
+            active_ = 0;
+            if (!error)
+                error = error_;
+        }
+        busy_.store(false);
+        if (error)
+            std::rethrow_exception(error);
+        return true;
+    }
+
+    namespace {
+
+        /// Tranche [lo, hi) d’un thread, sur sa propre ligne de cache ; modifiée sous mutex
+        struct alignas(64) WorkRange {
+            std::mutex mutex;
+            std::atomic<int> lo{ 0 }, hi{ 0 };
+        };
+
+    } // namespace
+
+    void parallelFor(int threads, int count, const std::function<void(int)>& body) {
+        threads = std::min<int>(threads, count);
+        std::vector<WorkRange> ranges(std::max<int>(threads, 1));
+        for (int t = 0; t < threads; ++t) {
+            ranges[t].lo = static_cast<int>(static_cast<long long>(count) * t / threads);
+            ranges[t].hi = static_cast<int>(static_cast<long long>(count) * (t + 1) / threads);
+        }
+
+        auto task = [&](int t) {
+            WorkRange& own = ranges[t];
+            for (;;) {
+                int k = -1;
+                {
+                    std::lock_guard<std::mutex> lock(own.mutex);
+                    if (own.lo.load() < own.hi.load())
+                        k = own.lo++;
+                }
+                if (k >= 0) {
+                    body(k);
+                    continue;
+                }
+
+                // Victime : la plus longue tranche restante (lue sans verrou, revérifiée ensuite)
+                int victim = -1, longest = 0;
+                for (int v = 0; v < threads; ++v) {
+                    int left = ranges[v].hi.load(std::memory_order_relaxed) - ranges[v].lo.load(std::memory_order_relaxed);
+                    if (v != t && left > longest) {
+                        longest = left;
+                        victim = v;
+                    }
+                }
+                if (victim < 0)
+                    return;
+
+                int lo, hi;
+                {
+                    std::lock_guard<std::mutex> lock(ranges[victim].mutex);
+                    lo = (ranges[victim].lo.load() + ranges[victim].hi.load()) / 2;
+                    hi = ranges[victim].hi.load();
+                    if (lo >= hi)
+                        continue;
+                    ranges[victim].hi.store(lo);
+                }
+                std::lock_guard<std::mutex> lock(own.mutex);
+                own.lo.store(lo);
+                own.hi.store(hi);
+            }
+        };
+
+        if (threads <= 1 || !ThreadPool::instance().run(threads, task)) {
+            for (int k = 0; k < count; ++k)
+                body(k);
+        }
+    }
+
+} // namespace crr
@@ -0,0 +1,104 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace crr {
+
+    /**
+     * @brief Nombre maximal de threads par cœur accepté par threadCount().
+     */
+    const int maxThreadsPerCore = 4;
+
+    /**
+     * @brief Nombre de threads effectif.
+     * @param requested Nombre demandé (0 : tous les cœurs disponibles), borné à maxThreadsPerCore
+     *                  fois le nombre de cœurs.
+     */
+    int threadCount(int requested);
+
+    /**
+     * @brief Barrière réutilisable pour un nombre fixe de threads.
+     * @details Attente active brève puis cession du cœur : les blocs synchronisés durent de
+     *          l’ordre de la milliseconde, un réveil par le noyau coûterait plus cher.
+     */
+    class Barrier {
+    private:
+        const int count_;
+        std::atomic<int> arrived_;
+        std::atomic<unsigned> generation_;
+        std::atomic<bool> broken_;              ///< Vrai après abort()
+
+    public:
+        explicit Barrier(int count) : count_(count), arrived_(0), generation_(0), broken_(false) {}
+
+        /**
+         * @brief Bloque jusqu’à ce que les count threads aient atteint la barrière.
+         * @return false si la barrière a été rompue par abort() : le thread doit abandonner sa tâche.
+         */
+        bool wait();
+
+        /**
+         * @brief Rompt définitivement la barrière et libère les threads en attente.
+         * @details Appelée par un thread qui quitte sa tâche sur une exception : sans elle, les
+         *          autres attendraient indéfiniment un thread qui n’arrivera jamais.
+         */
+        void abort();
+    };
+
+    /**
+     * @brief Pool de threads persistant, partagé par les moteurs.
+     * @details Les threads sont créés à la première demande puis réutilisés. Une seule tâche
+     *          s’exécute à la fois : un appel concurrent ou imbriqué est refusé et l’appelant
+     *          se rabat sur le calcul séquentiel. Le pool n’est jamais détruit : à la fin du
+     *          processus, le déchargement de la DLL s’exécute sous le verrou du chargeur, où
+     *          attendre la fin des threads peut bloquer ; le système les termine lui-même.
+     */
+    class ThreadPool {
+    private:
+        std::vector<std::thread> workers_;
+        std::atomic<bool> busy_;                ///< Vrai pendant l’exécution d’une tâche
+        std::mutex mutex_;
+        std::condition_variable start_, done_;
+        const std::function<void(int)>* task_;
+        int active_;                            ///< Nombre de threads participant à la tâche
+        int pending_;                           ///< Threads du pool n’ayant pas terminé
+        unsigned generation_;
+        std::exception_ptr error_;
+
+        ThreadPool();
+        void workerLoop(int index);
+
+    public:
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        static ThreadPool& instance();
+
+        /**
+         * @brief Exécute task(t) pour t = 0..threads-1 simultanément, t = 0 sur le thread appelant.
+         * @return false, sans rien exécuter, si le pool est déjà occupé (y compris par un appel
+         *         imbriqué depuis une tâche en cours) ou si le système refuse de créer les threads.
+         */
+        bool run(int threads, const std::function<void(int)>& task);
+    };
+
+    /**
+     * @brief Exécute body(k) pour k = 0..count-1 sur threads threads, avec vol de travail.
+     * @details Chaque thread part d’une tranche contiguë d’indices qu’il consomme par le début ;
+     *          sa tranche épuisée, il vole la moitié supérieure (arrondie au-dessus) de la plus longue tranche restante.
+     *          Les tâches de durées inégales restent réparties sans file centrale. Séquentiel,
+     *          dans l’ordre croissant, si threads <= 1 ou si le pool est occupé.
+     * @param body Appelé avec l’indice de la tâche ; les tâches doivent être indépendantes.
+     */
+    void parallelFor(int threads, int count, const std::function<void(int)>& body);
+
+} // namespace crr
+
+#endif // THREADPOOL_H
@@ -0,0 +1,129 @@
+#ifndef TILING_H
+#define TILING_H
+
+#include "Lattice.h"
+#include "Settings.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cstring>
+
+namespace crr {
+
+    /**
+     * @brief Rétropropagation en place pavée dans le temps (tuiles en parallélogramme).
+     * @details Les niveaux sont traités par blocs de `levels` pas. Dans un bloc partant du
+     *          niveau top, la tuile [a, b) couvre les nœuds [a - k, b - k) du niveau top - k :
+     *          elle glisse d’un nœud vers la gauche à chaque niveau, comme la dépendance
+     *          (n, i) <- (n + 1, i), (n + 1, i + 1). Les tuiles sont parcourues de gauche à
+     *          droite ; chacune ne lit que ses propres valeurs et le nœud a - k laissé au
+     *          niveau précédent par sa voisine de gauche, jamais écrasé ensuite. Chaque nœud
+     *          est donc calculé par la même expression, à partir des mêmes opérandes, que
+     *          dans la boucle non pavée : les résultats sont identiques au bit près, seul
+     *          l’ordre de parcours change. Une tuile de `width` valeurs reste en cache pendant
+     *          ses `levels` pas au lieu de relire tout le niveau à chaque pas.
+     * @param N      Niveau de départ (valeurs terminales déjà en place).
+     * @param stop   Niveau d’arrêt (0 pour aller jusqu’à la racine).
+     * @param width  Largeur des tuiles en nœuds (> 0).
+     * @param levels Nombre de niveaux avancés par tuile (> 0).
+     * @param step   Appelé avec (n, i0, count) : calcule en place les nœuds (n, i0) à
+     *               (n, i0 + count - 1) à partir du niveau n + 1 ; count <= width.
+     */
+    template<typename TStep>
+    void tiledInduction(int N, int stop, int width, int levels, TStep&& step) {
+        for (int top = N; top > stop; top -= levels) {
+            int bottom = std::max<int>(top - levels, stop);
+            for (int a = 0; a <= top; a += width) {
+                // La dernière tuile va jusqu’au bord droit du niveau
+                bool last = a + width > top;
+                for (int n = top - 1; n >= bottom; --n) {
+                    int k = top - n;
+                    int lo = std::max<int>(a - k, 0);
+                    int hi = last ? n + 1 : a + width - k;
+                    if (hi > lo)
+                        step(n, lo, hi - lo);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Rétropropagation parallèle par blocs de niveaux avec halo.
+     * @details Chaque bloc avance settings.tileLevels niveaux. Le niveau d’arrivée est découpé
+     *          en une tranche contiguë par thread ; le thread copie sa tranche du niveau de
+     *          départ, prolongée à droite d’autant de nœuds que le bloc a de niveaux (le halo),
+     *          dans un tampon local, la rétropropague en place puis écrit sa tranche dans le
+     *          second tampon global. Les nœuds du halo sont recalculés par deux threads voisins,
+     *          à partir des mêmes opérandes : les résultats restent identiques au calcul
+     *          séquentiel. Une seule barrière par bloc. Dès qu’un niveau compte moins de
+     *          settings.parallelCutoff nœuds, la fin de l’arbre est laissée à l’appelant.
+     * @param V        Niveau N en entrée (N + 1 valeurs) ; niveau renvoyé en sortie.
+     * @param N        Niveau de départ.
+     * @param stop     Niveau en dessous duquel le calcul n’est jamais poursuivi.
+     * @param settings Nombre de threads, seuil séquentiel et hauteur des blocs.
+     * @param step     Appelé avec (t, n, i0, count, W) : calcule en place dans W les nœuds
+     *                 (n, i0) à (n, i0 + count - 1), W[0] correspondant au nœud i0 et W[count]
+     *                 au nœud (n + 1, i0 + count) ; t est l’indice du thread.
+     * @return Niveau atteint, entre stop et N (N si le calcul reste séquentiel).
+     */
+    template<typename TStep>
+    int parallelInduction(double* V, int N, int stop, const Settings& settings, TStep&& step) {
+        int threads = threadCount(settings.threads);
+        int levels = std::max<int>(settings.tileLevels, 1);
+        int cutoff = std::max<int>(settings.parallelCutoff, 1);
+        if (threads <= 1 || N + 1 < cutoff || N <= stop)
+            return N;
+
+        // Blocs [bottom, top] traités en parallèle
+        int last = N;
+        while (last > stop && last + 1 >= cutoff)
+            last = std::max<int>(last - levels, stop);
+
+        // Tampons locaux alloués d’avance : tranche du premier bloc, la plus large, et son halo
+        AlignedVector other(N + 1);
+        int width = std::min<int>((N - levels + threads) / threads + levels, N + 1);
+        std::vector<AlignedVector> locals(threads, AlignedVector(std::max<int>(width, 1)));
+        Barrier barrier(threads);
+        auto task = [&](int t) {
+            double* local = locals[t].data();
+            double* src = V;
+            double* dst = other.data();
+            try {
+                for (int top = N; top > last; top = std::max<int>(top - levels, last)) {
+                    int bottom = std::max<int>(top - levels, last);
+                    int chunk = (bottom + 1 + threads - 1) / threads;
+                    int a = std::min<int>(t * chunk, bottom + 1);
+                    int b = std::min<int>(a + chunk, bottom + 1);
+                    if (a < b) {
+                        int e = std::min<int>(b + (top - bottom), top + 1);
+                        std::memcpy(local, src + a, (e - a) * sizeof(double));
+                        for (int n = top - 1; n >= bottom; --n)
+                            step(t, n, a, e - (top - n) - a, local);
+                        std::memcpy(dst + a, local, (b - a) * sizeof(double));
+                    }
+                    if (!barrier.wait())
+                        return;
+                    std::swap(src, dst);
+                }
+            }
+            catch (...) {
+                // Libère les autres threads ; le pool relance l’exception dans l’appelant
+                barrier.abort();
+                throw;
+            }
+        };
+
+        if (!ThreadPool::instance().run(threads, task))
+            return N;
+
+        // Nombre de blocs impair : le dernier niveau est dans le tampon secondaire
+        int blocks = 0;
+        for (int top = N; top > last; top = std::max<int>(top - levels, last))
+            ++blocks;
+        if (blocks & 1)
+            std::memcpy(V, other.data(), (last + 1) * sizeof(double));
+        return last;
+    }
+
+} // namespace crr
+
+#endif // TILING_H
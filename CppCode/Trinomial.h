@@ -0,0 +1,214 @@
+#ifndef TRINOMIAL_H
+#define TRINOMIAL_H
+
+#include "Option.h"
+#include "Kernels.h"
+
+namespace crr {
+
+    /**
+     * @brief Type d’exercice d’une option.
+     */
+    enum class Exercise {
+        European,  ///< Exercice à l’échéance uniquement.
+        American   ///< Exercice possible à chaque pas.
+    };
+
+    /**
+     * @brief Option sur arbre trinomial recombinant (Kamrad-Ritchken).
+     * @details Le logarithme du sous-jacent avance de +dx, 0 ou -dx par pas, avec
+     *          dx = lambda sigma sqrt(dt) et les probabilités
+     *          pu, pd = 1/(2 lambda²) ± (r - sigma²/2) sqrt(dt) / (2 lambda sigma), pm = 1 - 1/lambda².
+     *          lambda vaut sqrt(3/2) (pm = 1/3), puis est ajusté pour qu’un nœud terminal tombe
+     *          exactement sur le strike (Settings::strike, à défaut celui du payoff), ce qui
+     *          supprime l’essentiel de l’oscillation de l’erreur en N. L’alignement n’est retenu
+     *          que si lambda reste dans [1, 1.5] : au-delà, sqrt(3/2) est conservé. Les prix des nœuds du
+     *          niveau n forment une tranche des 2N + 1 prix terminaux : sous-jacent et valeurs
+     *          d’exercice sont calculés une seule fois. Settings::parameterization ne s’applique pas.
+     * @tparam TPayoff Type de payoff.
+     */
+    template<typename TPayoff>
+    class Trinomial : public Option {
+    private:
+        TPayoff payoff_;
+        Exercise exercise_;
+        double lambda_, dx_;            ///< Écartement relatif et pas du logarithme du sous-jacent
+        double qu_, qm_, qd_;           ///< Probabilités risque-neutres actualisées (hausse, stable, baisse)
+        AlignedVector stock_;           ///< S0 exp((k - N) dx), k = 0..2N : le niveau n commence en N - n
+        AlignedVector exerciseValues_;  ///< Payoff aux mêmes prix
+
+        /**
+         * @brief Paramètres transmis à Option : paramétrisation classique, jamais rejetée.
+         */
+        static Settings binomialSettings(Settings settings) {
+            settings.parameterization = Parameterization::Classic;
+            return settings;
+        }
+
+        /**
+         * @brief Prix du sous-jacent au niveau n (2n + 1 valeurs).
+         */
+        const double* stockLevel(int n) const { return stock_.data() + (N_ - n); }
+
+        /**
+         * @brief Valeurs d’exercice au niveau n (2n + 1 valeurs).
+         */
+        const double* exerciseLevel(int n) const { return exerciseValues_.data() + (N_ - n); }
+
+        /**
+         * @brief Rétropropagation en place du niveau from au niveau to.
+         * @param V Niveau from en entrée ; V[0..2 to] contient le niveau to en sortie.
+         */
+        void induction(AlignedVector& V, int from, int to) const;
+
+    public:
+        /**
+         * @brief Couverture delta / obligation niveau par niveau (2n + 1 nœuds au niveau n).
+         * @details Le marché trinomial est incomplet : le delta (V(n + 1, j + 2) - V(n + 1, j)) / (Su - Sd)
+         *          couvre les mouvements extrêmes, le mouvement central laisse un résidu de l’ordre de gamma dx².
+         */
+        using Hedging = HedgingStrategy<TrinomialLattice>;
+
+        Trinomial(double S0, double R, double sigma, double T, int N, const TPayoff& payoff,
+            Exercise exercise = Exercise::European, const Settings& settings = Settings());
+
+        TrinomialLattice treePrice() const;
+        Hedging hedgingStrategy() const;
+
+        /**
+         * @brief Prix initial par rétropropagation en place dans un tampon de 2N + 1 valeurs.
+         * @return Valeur de l’option à n = 0, identique à treePrice()(0, 0).
+         */
+        double price() const override;
+
+        /**
+         * @brief Sensibilités lues sur le niveau 1, dont le nœud central est en S0.
+         * @details Theta est la différence (V(1, 1) - V(0, 0)) / dt, sans correction de sous-jacent.
+         */
+        Greeks greeks() const override;
+
+        /**
+         * @brief Écartement lambda retenu (sqrt(3/2) ou la valeur, dans [1, 1.5], alignant le strike).
+         */
+        double stretch() const { return lambda_; }
+    };
+
+    template<typename TPayoff>
+    Trinomial<TPayoff>::Trinomial(double S0, double R, double sigma, double T, int N,
+        const TPayoff& payoff, Exercise exercise, const Settings& settings)
+        : Option(S0, R, sigma, T, N, binomialSettings(settings)), payoff_(payoff), exercise_(exercise)
+    {
+        if (sigma_ <= 0.0 || T_ <= 0.0)
+            throw std::invalid_argument("Sigma et T doivent être > 0 pour l’arbre trinomial");
+
+        double dt = T_ / N_;
+        double base = sigma_ * std::sqrt(dt);
+        lambda_ = std::sqrt(1.5);
+
+        // Alignement : ln(K / S0) = j dx avec 1 <= j <= N et 1 <= lambda <= maxStretch ; j est
+        // l’entier le plus proche de x / (sqrt(3/2) base) compatible avec lambda >= 1. Un lambda
+        // plus grand dégrade l’arbre davantage que l’alignement ne le corrige : sqrt(3/2) est conservé.
+        const double maxStretch = 1.5;
+        double K = settings_.strike > 0.0 ? settings_.strike : payoff_.strike();
+        if (K > 0.0 && S0_ > 0.0) {
+            double x = std::fabs(std::log(K / S0_));
+            int j = std::min<int>(int(std::floor(x / base)), int(std::lround(x / (lambda_ * base))));
+            if (j < 1 && x >= base)
+                j = 1;
+            if (j >= 1 && j <= N_ && x / (j * base) <= maxStretch)
+                lambda_ = x / (j * base);
+        }
+
+        dx_ = lambda_ * base;
+        double nu = R_ - 0.5 * sigma_ * sigma_;
+        double drift = nu * std::sqrt(dt) / (2.0 * lambda_ * sigma_);
+        double pu = 0.5 / (lambda_ * lambda_) + drift;
+        double pd = 0.5 / (lambda_ * lambda_) - drift;
+        double pm = 1.0 - 1.0 / (lambda_ * lambda_);
+        if (!(pu > 0.0 && pd > 0.0 && pm >= 0.0))
+            throw std::invalid_argument("Probabilité trinomiale hors de [0, 1] : augmenter N");
+
+        double disc = std::exp(-R_ * dt);
+        qu_ = disc * pu;
+        qm_ = disc * pm;
+        qd_ = disc * pd;
+
+        stock_.resize(2 * N_ + 1);
+        for (int k = 0; k <= 2 * N_; ++k)
+            stock_[k] = S0_ * std::exp((k - N_) * dx_);
+        exerciseValues_.resize(2 * N_ + 1);
+        payoff_.evaluate(stock_.data(), exerciseValues_.data(), 2 * N_ + 1);
+    }
+
+    template<typename TPayoff>
+    void Trinomial<TPayoff>::induction(AlignedVector& V, int from, int to) const {
+        // V[j] n'est plus lu une fois le nœud (n, j) calculé : mise à jour en place
+        for (int n = from - 1; n >= to; --n) {
+            if (exercise_ == Exercise::American)
+                simd::rollbackMax3(V.data(), exerciseLevel(n), 2 * n + 1, qu_, qm_, qd_);
+            else
+                simd::rollback3(V.data(), 2 * n + 1, qu_, qm_, qd_);
+        }
+    }
+
+    template<typename TPayoff>
+    TrinomialLattice Trinomial<TPayoff>::treePrice() const {
+        TrinomialLattice V(N_ + 1);
+        std::copy(exerciseValues_.begin(), exerciseValues_.end(), V[N_].begin());
+        for (int n = N_ - 1; n >= 0; --n) {
+            if (exercise_ == Exercise::American)
+                simd::stepMax3(V[n + 1].data(), exerciseLevel(n), V[n].data(), 2 * n + 1, qu_, qm_, qd_);
+            else
+                simd::step3(V[n + 1].data(), V[n].data(), 2 * n + 1, qu_, qm_, qd_);
+        }
+        return V;
+    }
+
+    template<typename TPayoff>
+    double Trinomial<TPayoff>::price() const {
+        AlignedVector V(exerciseValues_);
+        induction(V, N_, 0);
+        return V[0];
+    }
+
+    template<typename TPayoff>
+    typename Trinomial<TPayoff>::Greeks Trinomial<TPayoff>::greeks() const {
+        AlignedVector V(exerciseValues_);
+        induction(V, N_, 1);
+        double V1[3] = { V[0], V[1], V[2] };
+        induction(V, 1, 0);
+
+        const double* S = stockLevel(1);
+        Greeks g;
+        g.price = V[0];
+        g.delta = (V1[2] - V1[0]) / (S[2] - S[0]);
+        double deltaUp = (V1[2] - V1[1]) / (S[2] - S[1]);
+        double deltaDown = (V1[1] - V1[0]) / (S[1] - S[0]);
+        g.gamma = (deltaUp - deltaDown) / (0.5 * (S[2] - S[0]));
+        g.theta = (V1[1] - V[0]) / (T_ / N_);
+        return g;
+    }
+
+    template<typename TPayoff>
+    typename Trinomial<TPayoff>::Hedging Trinomial<TPayoff>::hedgingStrategy() const {
+        TrinomialLattice V = treePrice();
+        Hedging H{ TrinomialLattice(N_), TrinomialLattice(N_) };
+        for (int n = 0; n < N_; ++n) {
+            const double* S = stockLevel(n);
+            const double* Snext = stockLevel(n + 1);
+            auto Vn = V[n];
+            auto Vnext = V[n + 1];
+            auto delta = H.delta[n];
+            auto bond = H.bond[n];
+            for (int j = 0; j <= 2 * n; ++j) {
+                double dlt = (Vnext[j + 2] - Vnext[j]) / (Snext[j + 2] - Snext[j]);
+                delta[j] = dlt;
+                bond[j] = Vn[j] - dlt * S[j];
+            }
+        }
+        return H;
+    }
+
+} // namespace crr
+
+#endif // TRINOMIAL_H